@@ -606,6 +606,10 @@ int main(int argc, char** argv){
         if(!opt_pre)
             S.eliminate(true);
 
+        if(strlen(opt_proof) > 0){
+            S.setProofFile(opt_proof, opt_proof_binary);
+        }
+
         gzFile in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
         if(in == NULL)
             printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
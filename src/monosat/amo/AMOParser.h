@@ -73,9 +73,7 @@ public:
             }
             if(lits.size() > 1){
                 //else this constraint has no effect
-                AMOTheory* amo = new AMOTheory(&S);
-                for(Lit l : lits)
-                    amo->addLit(l);
+                AMOTheory::getAMOTheory(&S)->addGroup(lits);
 
             }
             return true;
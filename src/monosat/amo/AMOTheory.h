@@ -23,27 +23,49 @@
 #define AMOTHEORY_H_
 
 #include "monosat/mtl/Vec.h"
+#include "monosat/mtl/Sort.h"
 #include "monosat/core/SolverTypes.h"
 #include "monosat/core/Theory.h"
+#include "monosat/core/Solver.h"
+#include "monosat/core/Config.h"
 
 namespace Monosat {
 
 
 //At-Most-One theory. This is a special case of PB constraints, for handling at-most-one constraints.
-//Each instance of this theory supports a _single_ at-most-one constraint; to implement multiple such constraints, instantiate multiple copies of the theory.
+//A single instance of this theory is shared by all at-most-one constraints ('groups') in a solver (use getAMOTheory()
+//to retrieve it). Each literal keeps a list of the groups it occurs in, so assigning a literal only touches
+//the groups that actually contain it.
+//At level 0, groups are simplified, overlapping groups are merged into larger cliques (when every pair of
+//literals in the merged group was already mutually exclusive), and small groups are converted to clauses.
 class AMOTheory : public Theory {
     Solver* S;
     int theory_index = -1;
 
+    struct Group {
+        vec<Lit> lits;//list of literals, at most one of which should be true.
+        Lit true_lit = lit_Undef;
+        Lit conflict_lit = lit_Undef;
+        bool needs_propagation = false;
+        bool in_queue = false;
+        bool clausified = false;
+        bool merged = false;//this group was subsumed by a larger group, and is no longer needed
+    };
+
 public:
 
     CRef assign_false_reason;
-    //CRef assign_true_reason;
 
-    vec<Lit> amo;//list of variables, at most one of which should be true.
-    VMap<Lit> positive;
+    vec<Group> groups;
+    vec<vec<int>> occurs;//for each literal, the groups that literal is a member of
+    vec<Lit> reason_lit;//for each variable that this theory assigned false, the true literal that forced that assignment
+    vec<int> prop_queue;//groups that have either a true literal or a conflict that have not yet been processed
     vec<Lit> tmp_clause;
 
+    bool needs_simplify = false;
+    int simplified_trail_size = -1;
+    int n_inactive = 0;//number of groups that are either clausified or merged
+
     double propagationtime = 0;
     int64_t stats_propagations = 0;
     int64_t stats_lit_propagations = 0;
@@ -51,11 +73,10 @@ public:
     int64_t stats_shrink_removed = 0;
     int64_t stats_reasons = 0;
     int64_t stats_conflicts = 0;
+    int64_t stats_groups_merged = 0;
+    int64_t stats_merge_lits_added = 0;
+    int64_t stats_clausified = 0;
 
-    Lit true_lit = lit_Undef;
-    Lit conflict_lit = lit_Undef;
-    bool needs_propagation = false;
-    bool clausified = false;
 public:
     const char* getTheoryType() override{
         return "AMO";
@@ -65,13 +86,19 @@ public:
             S(S){
         S->addTheory(this);
         assign_false_reason = S->newReasonMarker(this);
-        //assign_true_reason=S->newReasonMarker(this);
-
     }
 
     ~AMOTheory(){
     };
 
+    //Returns the (unique) at-most-one theory of this solver, creating it if necessary.
+    static AMOTheory* getAMOTheory(Solver* S){
+        if(!S->getAMOTheory()){
+            S->setAMOTheory(new AMOTheory(S));
+        }
+        return (AMOTheory*) S->getAMOTheory();
+    }
+
     static bool clausify_amo(Solver* S, const vec<Lit>& lits){
         vec<Lit> set;
 
@@ -112,22 +139,35 @@ public:
         return true;
     }
 
-
-    //Add a variable (not literal!) to the set of which at most one may be true.
-    void addVar(Var solverVar){
-        addLit(mkLit(solverVar));
-
+    //Add a new at-most-one constraint over the given literals.
+    //Returns the id of the new group.
+    int addGroup(const vec<Lit>& lits){
+        S->cancelUntil(0);
+        int groupID = groups.size();
+        groups.push();
+        Group& g = groups.last();
+        for(Lit l:lits){
+            Var v = var(l);
+            if(!S->theoryHasVar(v, this)){
+                S->newTheoryVar(v, getTheoryIndex(), v);//using same variable indices in the theory as out of the theory
+            }
+            occurs.growTo(2 * (v + 1));
+            reason_lit.growTo(v + 1, lit_Undef);
+            if(occurs[toInt(l)].size() && occurs[toInt(l)].last() == groupID){
+                continue;//this literal is already in the group
+            }
+            g.lits.push(l);
+            occurs[toInt(l)].push(groupID);
+        }
+        needs_simplify = true;
+        S->resetInitialPropagation();
+        return groupID;
     }
 
-    //Add a literal to the set of which at most one may be true.
-    void addLit(Lit solverLit){
-        S->newTheoryVar(var(solverLit), getTheoryIndex(),
-                        var(solverLit));//using same variable indices in the theory as out of the theory
-        amo.push(solverLit);
-        positive.insert(var(solverLit), solverLit, lit_Undef);
+    int nGroups() const{
+        return groups.size();
     }
 
-
     inline int getTheoryIndex() const override{
         return theory_index;
     }
@@ -144,119 +184,117 @@ public:
 
     }
 
+    bool supportsChronologicalBacktracking() override{
+        return true;
+    }
+
+    bool supportsSkippingBacktrack() override{
+        return true;
+    }
+
     inline int decisionLevel(){
         return S->decisionLevel();
     }
 
     inline void undecideTheory(Lit l) override{
-        if(l == true_lit){
-            needs_propagation = false;
-            true_lit = lit_Undef;
-            assert(conflict_lit == lit_Undef);
-        }
-        if(l == conflict_lit){
-            conflict_lit = lit_Undef;
+        if(toInt(l) >= occurs.size())
+            return;
+        for(int gID:occurs[toInt(l)]){
+            Group& g = groups[gID];
+            if(l == g.conflict_lit){
+                g.conflict_lit = lit_Undef;
+            }else if(l == g.true_lit){
+                g.needs_propagation = false;
+                g.true_lit = lit_Undef;
+                if(g.conflict_lit != lit_Undef){
+                    //the conflicting literal was assigned first; it is now the only true literal of this group
+                    g.true_lit = g.conflict_lit;
+                    g.conflict_lit = lit_Undef;
+                    g.needs_propagation = true;
+                    enqueueGroup(gID);
+                }
+            }
         }
     }
 
     void enqueueTheory(Lit l) override{
-        if(clausified)
+        if(toInt(l) >= occurs.size())
             return;
-        if(conflict_lit == lit_Undef){
-            Lit expected = positive[var(l)];
-            if(l == expected){
-                if(true_lit == lit_Undef){
-                    true_lit = l;
-                    assert(!needs_propagation);
-                    if(opt_amo_eager_prop){
-                        //enqueue all of the remaining lits in the solver, now.
-                        stats_propagations++;
-                        for(Lit l:amo){
-                            if(l != true_lit){
-                                S->enqueue(~l, assign_false_reason);
-                            }
-                        }
-                    }else{
-                        needs_propagation = true;
-                    }
-                }else if(l == true_lit){
-                    //we already knew this lit was assigned to true, do nothing.
+        for(int gID:occurs[toInt(l)]){
+            Group& g = groups[gID];
+            if(g.clausified || g.merged || g.conflict_lit != lit_Undef)
+                continue;
+            if(g.true_lit == lit_Undef){
+                g.true_lit = l;
+                assert(!g.needs_propagation);
+                if(opt_amo_eager_prop){
+                    //enqueue all of the remaining lits in the solver, now.
+                    stats_propagations++;
+                    propagateGroup(g);
                 }else{
-                    //there is a conflict - both conflict_lit and true_lit are assigned true, which is not allowed.
-                    conflict_lit = l;
+                    g.needs_propagation = true;
+                    enqueueGroup(gID);
                 }
+            }else if(l == g.true_lit){
+                //we already knew this lit was assigned to true, do nothing.
             }else{
-                //it is always safe to assign a var to false.
+                //there is a conflict - both conflict_lit and true_lit are assigned true, which is not allowed.
+                g.conflict_lit = l;
+                enqueueGroup(gID);
             }
         }
     };
 
     bool propagateTheory(vec<Lit>& conflict) override{
-        if(clausified){
+        if(groups.size() > 0 && n_inactive == groups.size()){
             S->setTheorySatisfied(this);
             return true;
         }
         S->theoryPropagated(this);
-        if(decisionLevel() == 0){
-            //remove constants from the set
-            int n_nonconstants = 0;
-            bool has_true_lit = false;
-            int i, j = 0;
-            for(i = 0; i < amo.size(); i++){
-                Lit l = amo[i];
-                if(S->value(l) == l_False && S->level(var(l)) == 0){
-                    //drop this literal from the set
-                }else if(S->value(l) == l_True && S->level(var(l)) == 0){
-                    amo[j++] = l;
-                    has_true_lit = true;
-                }else{
-                    n_nonconstants++;
-                    amo[j++] = l;
-                }
+        if(decisionLevel() == 0 && (needs_simplify || simplified_trail_size != S->nAssigns())){
+            if(!simplify()){
+                return false;
             }
-            amo.shrink(i - j);
-            if(has_true_lit || amo.size() == 0 || amo.size() <= opt_clausify_amo){
-                clausified = true;
-                vec<Lit> amoLits;
-                for(Lit l:amo){
-                    amoLits.push(l);
-                }
-                if(opt_verb > 1){
-                    printf("Clausifying amo theory %d with %d lits\n", this->getTheoryIndex(), amo.size());
-                }
+            if(n_inactive == groups.size()){
                 S->setTheorySatisfied(this);
-                return clausify_amo(S, amoLits);
+                return true;
             }
         }
 
-        if(conflict_lit != lit_Undef){
-            conflict.clear();
-            assert(true_lit != lit_Undef);
-            assert(true_lit != conflict_lit);
-            conflict.push(~conflict_lit);
-            conflict.push(~true_lit);
-            needs_propagation = false;
-            stats_conflicts++;
-            return false;
-        }else if(true_lit != lit_Undef && needs_propagation){
-            stats_propagations++;
-            needs_propagation = false;
-            assert(!opt_amo_eager_prop);
-            //enqueue all of the remaining lits in the solver, now.
-            for(Lit l:amo){
-                if(l != true_lit){
-                    stats_lit_propagations++;
-                    S->enqueue(~l, assign_false_reason);
-                }
+        while(prop_queue.size()){
+            int gID = prop_queue.last();
+            Group& g = groups[gID];
+            if(g.conflict_lit != lit_Undef && !g.clausified && !g.merged){
+                //leave this group in the queue, so that the conflict is reported again if it is not resolved by backtracking
+                conflict.clear();
+                assert(g.true_lit != lit_Undef);
+                assert(g.true_lit != g.conflict_lit);
+                conflict.push(~g.conflict_lit);
+                conflict.push(~g.true_lit);
+                g.needs_propagation = false;
+                stats_conflicts++;
+                return false;
+            }
+            prop_queue.pop();
+            g.in_queue = false;
+            if(g.clausified || g.merged)
+                continue;
+            if(g.true_lit != lit_Undef && g.needs_propagation){
+                stats_propagations++;
+                g.needs_propagation = false;
+                propagateGroup(g);
+            }else{
+                stats_propagations_skipped++;
             }
         }
         return true;
     }
 
     void printStats(int detailLevel) override{
-        if(!clausified){
+        if(n_inactive < groups.size() || stats_groups_merged > 0){
             printf("AMO Theory %d stats:\n", this->getTheoryIndex());
-
+            printf("Groups: %d (%" PRId64 " clausified, %" PRId64 " merged into larger groups, %" PRId64 " lits added by merging)\n",
+                   groups.size(), stats_clausified, stats_groups_merged, stats_merge_lits_added);
             printf("Propagations: %" PRId64 " (%f s, avg: %f s, %" PRId64 " skipped,  %" PRId64 " lits)\n",
                    stats_propagations, propagationtime,
                    (propagationtime) / ((double) stats_propagations + 1), stats_propagations_skipped,
@@ -276,33 +314,245 @@ public:
     inline void buildReason(Lit p, vec<Lit>& reason, CRef reason_marker) override{
         stats_reasons++;
         assert(reason_marker == assign_false_reason);
-        if(p != true_lit){
-            assert(sign(p));
-            assert(S->value(p) == l_True);
-            assert(S->value(true_lit) == l_True);
-            reason.push(p);
-            reason.push(~true_lit);//either true_lit (currently assigned true) must be false, or p must be false
-        }else{
-            assert(false);
-        }
+        Lit true_lit = reason_lit[var(p)];
+        assert(true_lit != lit_Undef);
+        assert(S->value(p) == l_True);
+        assert(S->value(true_lit) == l_True);
+        reason.push(p);
+        reason.push(~true_lit);//either true_lit (currently assigned true) must be false, or p must be false
     }
 
     bool check_solved() override{
-        int n_true = 0;
-        for(Lit l:amo){
-            if(S->value(l) == l_True){
-                n_true += 1;
-                if(n_true > 1){
-                    return false;
+        for(Group& g:groups){
+            if(g.merged)
+                continue;
+            int n_true = 0;
+            for(Lit l:g.lits){
+                if(S->value(l) == l_True){
+                    n_true += 1;
+                    if(n_true > 1){
+                        return false;
+                    }
                 }
             }
         }
-
         return true;
     }
 
 private:
 
+    void enqueueGroup(int gID){
+        if(!groups[gID].in_queue){
+            groups[gID].in_queue = true;
+            prop_queue.push(gID);
+        }
+    }
+
+    //Assign all literals of the group other than its true literal to false.
+    void propagateGroup(Group& g){
+        Lit true_lit = g.true_lit;
+        for(Lit l:g.lits){
+            if(l != true_lit && S->value(l) == l_Undef){
+                stats_lit_propagations++;
+                reason_lit[var(l)] = true_lit;
+                S->enqueue(~l, assign_false_reason);
+            }
+        }
+    }
+
+    //Level 0 simplification: remove constant literals from each group, merge overlapping groups into larger cliques,
+    //and convert groups with a constant true literal, or with few literals, into clauses.
+    //Adding clauses may assign further literals at level 0, so this repeats until no new literals are assigned.
+    bool simplify(){
+        assert(decisionLevel() == 0);
+        needs_simplify = false;
+        bool merged = false;
+        while(true){
+            int trail_size = S->nAssigns();
+            for(Group& g:groups){
+                if(g.clausified || g.merged)
+                    continue;
+                //remove constants from the set
+                bool has_true_lit = false;
+                int i, j = 0;
+                for(i = 0; i < g.lits.size(); i++){
+                    Lit l = g.lits[i];
+                    if(S->value(l) == l_False){
+                        //drop this literal from the set
+                        stats_shrink_removed++;
+                    }else{
+                        has_true_lit |= S->value(l) == l_True;
+                        g.lits[j++] = l;
+                    }
+                }
+                g.lits.shrink(i - j);
+                if(has_true_lit || g.lits.size() <= 1){
+                    if(!clausify(g)){
+                        return false;
+                    }
+                }
+            }
+            if(trail_size != S->nAssigns())
+                continue;
+            if(!merged && opt_amo_merge_limit > 0){
+                rebuildOccurs();
+                mergeGroups();
+            }
+            merged = true;
+            for(Group& g:groups){
+                if(!g.clausified && !g.merged && g.lits.size() <= opt_clausify_amo){
+                    if(!clausify(g)){
+                        return false;
+                    }
+                }
+            }
+            if(trail_size == S->nAssigns())
+                break;
+        }
+        rebuildOccurs();
+        simplified_trail_size = S->nAssigns();
+        return true;
+    }
+
+    bool clausify(Group& g){
+        assert(!g.clausified);
+        g.clausified = true;
+        n_inactive++;
+        stats_clausified++;
+        if(opt_verb > 1){
+            printf("Clausifying amo group with %d lits\n", g.lits.size());
+        }
+        return clausify_amo(S, g.lits);
+    }
+
+    //Greedily extend each group with any literal that is already mutually exclusive (via other groups) with every
+    //literal in the group, and then drop all groups that are subsumed by the extended group.
+    //Assumes that all remaining literals are unassigned, and that occurs[] only lists live groups.
+    void mergeGroups(){
+        vec<int> order;
+        for(int i = 0; i < groups.size(); i++){
+            if(!groups[i].clausified && !groups[i].merged)
+                order.push(i);
+        }
+        //process the largest groups first, so that smaller groups are absorbed into them.
+        struct GroupSizeLt {
+            const vec<Group>& groups;
+
+            bool operator()(int a, int b) const{
+                return groups[a].lits.size() > groups[b].lits.size();
+            }
+
+            GroupSizeLt(const vec<Group>& groups) :
+                    groups(groups){
+            }
+        };
+        sort(order, GroupSizeLt(groups));
+
+        vec<char> in_group;
+        in_group.growTo(occurs.size(), false);
+        vec<int> seen;
+        seen.growTo(occurs.size(), -1);
+        vec<int> group_stamp;
+        group_stamp.growTo(groups.size(), -1);
+        int stamp = 0;
+
+        for(int gID:order){
+            Group& g = groups[gID];
+            if(g.merged || g.lits.size() == 0)
+                continue;
+            for(Lit l:g.lits)
+                in_group[toInt(l)] = true;
+
+            //candidate literals are those that share a group with the first literal of this group
+            int n_examined = 0;
+            int original_size = g.lits.size();
+            Lit first = g.lits[0];
+            for(int i = 0; i < occurs[toInt(first)].size() && n_examined < opt_amo_merge_limit; i++){
+                int hID = occurs[toInt(first)][i];
+                if(hID == gID || groups[hID].merged)
+                    continue;
+                for(int k = 0; k < groups[hID].lits.size() && n_examined < opt_amo_merge_limit; k++){
+                    Lit x = groups[hID].lits[k];
+                    if(in_group[toInt(x)] || seen[toInt(x)] == gID)
+                        continue;
+                    seen[toInt(x)] = gID;
+                    n_examined++;
+                    //x can join this group only if every literal of the group already shares a group with x
+                    stamp++;
+                    for(int xg:occurs[toInt(x)]){
+                        group_stamp[xg] = stamp;
+                    }
+                    bool exclusive = true;
+                    for(int j = 0; j < g.lits.size() && exclusive; j++){
+                        Lit y = g.lits[j];
+                        bool shares = false;
+                        for(int yg:occurs[toInt(y)]){
+                            if(group_stamp[yg] == stamp && !groups[yg].merged){
+                                shares = true;
+                                break;
+                            }
+                        }
+                        exclusive = shares;
+                    }
+                    if(exclusive){
+                        g.lits.push(x);
+                        in_group[toInt(x)] = true;
+                        stats_merge_lits_added++;
+                    }
+                }
+            }
+            for(int j = original_size; j < g.lits.size(); j++){
+                occurs[toInt(g.lits[j])].push(gID);
+            }
+
+            //remove any other groups that are now subsumed by this one
+            for(Lit l:g.lits){
+                for(int hID:occurs[toInt(l)]){
+                    Group& h = groups[hID];
+                    if(hID == gID || h.merged)
+                        continue;
+                    bool subsumed = true;
+                    for(Lit y:h.lits){
+                        if(!in_group[toInt(y)]){
+                            subsumed = false;
+                            break;
+                        }
+                    }
+                    if(subsumed){
+                        h.merged = true;
+                        n_inactive++;//merged groups are enforced by the group that subsumed them
+                        stats_groups_merged++;
+                    }
+                }
+            }
+
+            for(Lit l:g.lits)
+                in_group[toInt(l)] = false;
+        }
+    }
+
+    //Remove clausified and merged groups from the occurrence lists, and reset the state of the remaining groups.
+    //Only safe at level 0, after constant literals have been removed from all groups.
+    void rebuildOccurs(){
+        assert(decisionLevel() == 0);
+        for(vec<int>& occ:occurs){
+            occ.clear();
+        }
+        prop_queue.clear();
+        for(int gID = 0; gID < groups.size(); gID++){
+            Group& g = groups[gID];
+            g.true_lit = lit_Undef;
+            g.conflict_lit = lit_Undef;
+            g.needs_propagation = false;
+            g.in_queue = false;
+            if(g.clausified || g.merged){
+                continue;
+            }
+            for(Lit l:g.lits){
+                occurs[toInt(l)].push(gID);
+            }
+        }
+    }
 
 };
 
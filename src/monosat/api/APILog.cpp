@@ -0,0 +1,151 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2026, The MonoSAT Contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/api/APILog.h"
+#include <chrono>
+#include <stdexcept>
+
+using namespace Monosat;
+
+//size of the stdio buffer in front of the log
+static const size_t stdio_buffer_size = 1 << 16;
+//the writer thread is woken early once this much output is pending
+static const size_t write_threshold = 1 << 20;
+//pending output is written at least this often, so that the log on disk is never far behind
+static const std::chrono::milliseconds write_interval(500);
+
+APILog::APILog(const char* filename, bool compress){
+    if(compress){
+        gz_out = gzopen(filename, "wb");
+        if(!gz_out){
+            throw std::runtime_error("Could not open " + std::string(filename) + " for writing");
+        }
+    }else{
+        raw_out = fopen(filename, "w");
+        if(!raw_out){
+            throw std::runtime_error("Could not open " + std::string(filename) + " for writing");
+        }
+    }
+#if defined(__APPLE__) || defined(__FreeBSD__)
+    file = funopen(this, nullptr, [](void* cookie, const char* buf, int size) -> int{
+        return (int) cookieWrite(cookie, buf, size);
+    }, nullptr, cookieClose);
+#else
+    cookie_io_functions_t functions;
+    functions.read = nullptr;
+    functions.write = cookieWrite;
+    functions.seek = nullptr;
+    functions.close = cookieClose;
+    file = fopencookie(this, "w", functions);
+#endif
+    if(!file){
+        if(gz_out)
+            gzclose(gz_out);
+        if(raw_out)
+            fclose(raw_out);
+        throw std::runtime_error("Could not create log for " + std::string(filename));
+    }
+    setvbuf(file, nullptr, _IOFBF, stdio_buffer_size);
+    writer = std::thread(&APILog::writeLoop, this);
+}
+
+APILog::~APILog(){
+    fflush(file);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        closing = true;
+    }
+    wake_writer.notify_one();
+    writer.join();
+    fclose(file);
+    if(gz_out){
+        gzclose(gz_out);
+    }
+    if(raw_out){
+        fclose(raw_out);
+    }
+}
+
+void APILog::flush(){
+    fflush(file);
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t target = n_received;
+    flush_requested = true;
+    wake_writer.notify_one();
+    written.wait(lock, [&]{return n_written >= target || write_error;});
+}
+
+bool APILog::hasError(){
+    std::unique_lock<std::mutex> lock(mutex);
+    return write_error;
+}
+
+size_t APILog::receive(const char* buf, size_t size){
+    bool wake;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        pending.append(buf, size);
+        n_received += size;
+        wake = pending.size() >= write_threshold;
+    }
+    if(wake)
+        wake_writer.notify_one();
+    return size;
+}
+
+void APILog::writeLoop(){
+    std::unique_lock<std::mutex> lock(mutex);
+    while(true){
+        wake_writer.wait_for(lock, write_interval, [&]{
+            return closing || flush_requested || pending.size() >= write_threshold;
+        });
+        flush_requested = false;
+        if(pending.size()){
+            writing.swap(pending);
+            lock.unlock();
+            bool ok;
+            if(gz_out){
+                ok = gzwrite(gz_out, writing.data(), writing.size()) == (int) writing.size();
+                ok = ok && gzflush(gz_out, Z_SYNC_FLUSH) == Z_OK;
+            }else{
+                ok = fwrite(writing.data(), 1, writing.size(), raw_out) == writing.size();
+                ok = ok && fflush(raw_out) == 0;
+            }
+            lock.lock();
+            n_written += writing.size();
+            writing.clear();
+            if(!ok){
+                write_error = true;
+            }
+            written.notify_all();
+        }else if(closing){
+            break;
+        }
+    }
+}
+
+ssize_t APILog::cookieWrite(void* cookie, const char* buf, size_t size){
+    return ((APILog*) cookie)->receive(buf, size);
+}
+
+int APILog::cookieClose(void* cookie){
+    return 0;
+}
@@ -0,0 +1,87 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2026, The MonoSAT Contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef MONOSAT_APILOG_H
+#define MONOSAT_APILOG_H
+
+#include <zlib.h>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Monosat {
+
+/**
+ * Buffered writer for the GNF log of API calls (see setOutputFile).
+ * Output is written through an ordinary FILE* (so that the existing fprintf-based logging code can be used unchanged),
+ * but is accumulated in memory, and written to disk by a background thread, so that logging does not
+ * block on the file system after every call.
+ * If 'compress' is set, the log is written in gzip format (which the GNF parsers read directly).
+ */
+class APILog {
+    FILE* file = nullptr;
+    FILE* raw_out = nullptr;
+    gzFile gz_out = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable wake_writer;
+    std::condition_variable written;
+    std::string pending;//data received from 'file', not yet handed to the writer thread
+    std::string writing;//data currently being written by the writer thread
+    uint64_t n_received = 0;
+    uint64_t n_written = 0;
+    bool closing = false;
+    bool flush_requested = false;
+    bool write_error = false;
+    std::thread writer;
+
+public:
+    //Opens 'filename' for writing. Throws std::runtime_error if the file cannot be opened.
+    APILog(const char* filename, bool compress);
+
+    //Flushes and closes the log, waiting for the writer thread to finish.
+    ~APILog();
+
+    //The stdio handle that log output should be written to. Do not fclose this handle; delete the APILog instead.
+    FILE* getFile(){
+        return file;
+    }
+
+    //Blocks until all output written so far has been passed to the operating system.
+    void flush();
+
+    //True if the writer thread failed to write some of the output.
+    bool hasError();
+
+private:
+    void writeLoop();
+
+    size_t receive(const char* buf, size_t size);
+
+    static ssize_t cookieWrite(void* cookie, const char* buf, size_t size);
+
+    static int cookieClose(void* cookie);
+};
+}
+
+#endif //MONOSAT_APILOG_H
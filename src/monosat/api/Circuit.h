@@ -53,6 +53,7 @@ class Circuit {
     vec<Lit> clause;
     vec<Lit> store;
     FILE* outfile = nullptr;
+    bool flush_writes = true;
 
     inline int dimacs(Solver& S, Lit internalLit){
         Lit l = S.unmap(internalLit);
@@ -62,7 +63,8 @@ class Circuit {
     bool _addClause(Lit a){
         if(outfile){
             fprintf(outfile, "%d 0\n ", dimacs(S, a));
-            fflush(outfile);
+            if(flush_writes)
+                fflush(outfile);
         }
         return S.addClause(a);
     }
@@ -70,7 +72,8 @@ class Circuit {
     bool _addClause(Lit a, Lit b){
         if(outfile){
             fprintf(outfile, "%d %d 0\n ", dimacs(S, a), dimacs(S, b));
-            fflush(outfile);
+            if(flush_writes)
+                fflush(outfile);
         }
         return S.addClause(a, b);
     }
@@ -78,7 +81,8 @@ class Circuit {
     bool _addClause(Lit a, Lit b, Lit c){
         if(outfile){
             fprintf(outfile, "%d %d %d 0\n ", dimacs(S, a), dimacs(S, b), dimacs(S, c));
-            fflush(outfile);
+            if(flush_writes)
+                fflush(outfile);
         }
         return S.addClause(a, b, c);
     }
@@ -89,7 +93,8 @@ class Circuit {
                 fprintf(outfile, "%d ", dimacs(S, l));
             }
             fprintf(outfile, "0\n");
-            fflush(outfile);
+            if(flush_writes)
+                fflush(outfile);
         }
         return S.addClause(clause);
     }
@@ -133,8 +138,10 @@ public:
      * Specify a file to write constructed clauses to (in GNF format)
      * @param file
      */
-    void setOutputFile(FILE* file){
+    //If flush is false, the file is not flushed after each write (for files that are buffered, such as APILog)
+    void setOutputFile(FILE* file, bool flush = true){
         this->outfile = file;
+        this->flush_writes = flush;
     }
 
     Circuit(Solver& S) : S(S){
@@ -342,7 +342,23 @@ inline void write_out(Monosat::SimpSolver* S, const char* fmt, ...){
     }else{
         va_end(args);
     }
-    fflush(d->outfile);
+    if(!d->log){
+        fflush(d->outfile);
+    }
+}
+
+//Close the API log, if one is open
+static void closeOutputFile(MonosatData* d){
+    if(d->outfile){
+        d->circuit.setOutputFile(nullptr);
+        if(d->log){
+            delete d->log;//also closes outfile
+            d->log = nullptr;
+        }else{
+            fclose(d->outfile);
+        }
+        d->outfile = nullptr;
+    }
 }
 
 int varToLit(int variable, bool negated){
@@ -403,19 +419,27 @@ Var externalBV(Monosat::SimpSolver* S, int bvID){
 void setOutputFile(Monosat::SimpSolver* S, const char* output){
     MonosatData* d = (MonosatData*) S->_external_data;
     assert(d);
-    if(d->outfile){
-        fclose(d->outfile);
-        d->outfile = nullptr;
-        d->circuit.setOutputFile(nullptr);
-    }
+    closeOutputFile(d);
     if(output && strlen(output) > 0){
-        d->outfile = fopen(output, "w");
+        size_t len = strlen(output);
+        //logs ending in .gz are written compressed, which the GNF parsers (and loadGNF/readGNF) read directly
+        bool compress = len > 3 && strcmp(output + len - 3, ".gz") == 0;
+        if(opt_buffer_api_log || compress){
+            try{
+                d->log = new APILog(output, compress);
+                d->outfile = d->log->getFile();
+            }catch(std::exception& e){
+                api_errorf("%s", e.what());
+            }
+        }else{
+            d->outfile = fopen(output, "w");
+        }
     }
     write_out(S, "c monosat %s\n", d->args.c_str());
     if(S->const_true != lit_Undef){
         write_out(S, "%d 0\n", dimacs(S, S->True()));
     }
-    d->circuit.setOutputFile(d->outfile);
+    d->circuit.setOutputFile(d->outfile, d->log == nullptr);
 }
 
 const char* getVersion(){
@@ -504,6 +528,9 @@ Monosat::SimpSolver* newSolver_args(int argc, char** argv){
     if(!opt_pre){
         S->eliminate(true);//disable preprocessing.
     }
+    if(strlen(opt_proof) > 0){
+        S->setProofFile(opt_proof, opt_proof_binary);
+    }
     ((MonosatData*) S->_external_data)->pbsolver = new PB::PbSolver(*S);
     S->setPBSolver(((MonosatData*) S->_external_data)->pbsolver);
 
@@ -535,7 +562,9 @@ Monosat::SimpSolver* newSolver_args(int argc, char** argv){
 void flushFile(Monosat::SimpSolver* S){
     if(S->_external_data){
         MonosatData* data = (MonosatData*) S->_external_data;
-        if(data->outfile){
+        if(data->log){
+            data->log->flush();
+        }else if(data->outfile){
             fflush(data->outfile);
         }
     }
@@ -544,11 +573,7 @@ void flushFile(Monosat::SimpSolver* S){
 void closeFile(Monosat::SimpSolver* S){
     if(S->_external_data){
         MonosatData* data = (MonosatData*) S->_external_data;
-        if(data->outfile){
-            fclose(data->outfile);
-            data->outfile = nullptr;
-            data->circuit.setOutputFile(nullptr);
-        }
+        closeOutputFile(data);
     }
 }
 
@@ -566,10 +591,7 @@ void deleteSolver(Monosat::SimpSolver* S){
 #endif
             data->has_timer = false;
         }
-        if(data->outfile){
-            fclose(data->outfile);
-            data->outfile = nullptr;
-        }
+        closeOutputFile(data);
         delete (data);
         S->_external_data = nullptr;
     }
@@ -959,9 +981,6 @@ int _solve(Monosat::SimpSolver* S, int* assumptions, int n_assumptions){
 
     enforceTimeLimit(S);
 
-    S->cancelUntil(0);
-    S->preprocess();//do this _even_ if sat based preprocessing is disabled! Some of the theory solvers depend on a preprocessing call being made!
-
     vec<Monosat::Lit> assume;
     for(int i = 0; i < n_assumptions; i++){
         Lit l = internalLit(S, assumptions[i]);
@@ -972,6 +991,11 @@ int _solve(Monosat::SimpSolver* S, int* assumptions, int n_assumptions){
         //S->setFrozen(v,true); //this is done in the solve() call
     }
 
+    //backtrack only as far as the first assumption that differs from the last solve
+    //(preprocessing will still backtrack to level 0, if any theory has constraints to implement or adds clauses)
+    S->cancelUntilAssumptions(assume);
+    S->preprocess();//do this _even_ if sat based preprocessing is disabled! Some of the theory solvers depend on a preprocessing call being made!
+
 /*	  if (opt_pre){
 		S->eliminate(false);//should this really be set to disable future preprocessing here?
 	 }*/
@@ -1258,6 +1282,37 @@ bool addClause(Monosat::SimpSolver* S, int* lits, int n_lits){
     return S->addClause(clause);
 }
 
+bool addClauses(Monosat::SimpSolver* S, int* lits, int* offsets, int n_clauses){
+    assert(n_clauses >= 0);
+    if(n_clauses == 0)
+        return S->okay();
+    if(offsets[0] < 0){
+        api_errorf("Clause offsets must be non-negative (clause 0 starts at %d)", offsets[0]);
+    }
+    for(int i = 0; i < n_clauses; i++){
+        if(offsets[i + 1] < offsets[i]){
+            api_errorf("Clause offsets must be non-decreasing (clause %d starts at %d, but ends at %d)", i, offsets[i],
+                       offsets[i + 1]);
+        }
+    }
+    static vec<Lit> clause_lits;
+    clause_lits.clear();
+    clause_lits.growTo(offsets[n_clauses]);
+    for(int j = offsets[0]; j < offsets[n_clauses]; j++){
+        clause_lits[j] = internalLit(S, lits[j]);
+    }
+    MonosatData* d = (MonosatData*) S->_external_data;
+    if(d && d->outfile){
+        for(int i = 0; i < n_clauses; i++){
+            for(int j = offsets[i]; j < offsets[i + 1]; j++){
+                write_out(S, "%d ", dimacs(S, clause_lits[j]));
+            }
+            write_out(S, "0\n");
+        }
+    }
+    return S->addClauses(clause_lits, offsets, n_clauses);
+}
+
 bool addUnitClause(Monosat::SimpSolver* S, int lit){
 
     write_out(S, "%d 0\n", dimacs(S, internalLit(S, lit)));
@@ -1634,11 +1689,13 @@ void at_most_one(Monosat::SimpSolver* S, int* vars, int n_vars){
         }
 
         write_out(S, " 0\n");
-        AMOTheory* amo = new AMOTheory(S);
+        static vec<Lit> amo_lits;
+        amo_lits.clear();
         for(int i = 0; i < n_vars; i++){
             Var v = internalVar(S, vars[i]);
-            amo->addVar(v);
+            amo_lits.push(mkLit(v));
         }
+        AMOTheory::getAMOTheory(S)->addGroup(amo_lits);
     }
 }
 
@@ -1653,11 +1710,13 @@ void at_most_one_lit(Monosat::SimpSolver* S, int* literals, int n_lits){
         }
 
         write_out(S, " 0\n");
-        AMOTheory* amo = new AMOTheory(S);
+        static vec<Lit> amo_lits;
+        amo_lits.clear();
         for(int i = 0; i < n_lits; i++){
             Lit l = internalLit(S, literals[i]);
-            amo->addLit(l);
+            amo_lits.push(l);
         }
+        AMOTheory::getAMOTheory(S)->addGroup(amo_lits);
     }
 }
 
@@ -1786,11 +1845,12 @@ int nNodes(Monosat::SimpSolver* S, Monosat::GraphTheorySolver<int64_t>* G){
 }
 
 int nEdges(Monosat::SimpSolver* S, Monosat::GraphTheorySolver<int64_t>* G){
-    return G->nEdges();
+    //leave out the edges that replace contracted chains
+    return G->nEdges() - G->nChainEdges();
 }
 
 int getEdgeLiteralN(Monosat::SimpSolver* S, Monosat::GraphTheorySolver<int64_t>* G, int n){
-    if(n < 0 || n >= G->getEdges().size()){
+    if(n < 0 || n >= G->nEdges() - G->nChainEdges()){
         api_errorf("No such edge: %d", n);
     }
     return externalLit(S, G->toSolver(mkLit(G->getEdges()[n].v)));
@@ -2071,12 +2131,14 @@ void newEdgeSet(Monosat::SimpSolver* S, Monosat::GraphTheorySolver<int64_t>* G,
     //enforce that _exactly_ one edge from this edge set is assigned in the SAT solver
     if(enforceEdgeAssignment){
         S->addClause(edge_lits);
-        AMOTheory* amo = new AMOTheory(S);
+        static vec<Lit> amo_lits;
+        amo_lits.clear();
         for(Lit l:edge_lits){
             Var v = S->newVar();
             G->makeEqualInSolver(mkLit(v), l);
-            amo->addVar(v);
+            amo_lits.push(mkLit(v));
         }
+        AMOTheory::getAMOTheory(S)->addGroup(amo_lits);
     }
 }
 
@@ -2217,10 +2279,8 @@ bool hasModel(Monosat::SimpSolver* S){
     return S->hasModel();
 }
 
-//Returns 0 for true, 1 for false, 2 for unassigned.
-int getModel_Literal(Monosat::SimpSolver* S, int lit){
-    Lit l = internalLit(S, lit);
-
+//Returns 0 for true, 1 for false, 2 for unassigned, for an internal literal.
+static int modelValue(Monosat::SimpSolver* S, Lit l){
     if(var(l) < 0 || var(l) >= S->nVars())
         api_errorf("Variable %d is undefined", dimacs(S, l));
     else if(var(l) >= S->model.size()){
@@ -2239,6 +2299,17 @@ int getModel_Literal(Monosat::SimpSolver* S, int lit){
     return toInt(val);
 }
 
+//Returns 0 for true, 1 for false, 2 for unassigned.
+int getModel_Literal(Monosat::SimpSolver* S, int lit){
+    return modelValue(S, internalLit(S, lit));
+}
+
+void getModel_Literals(Monosat::SimpSolver* S, int n_lits, int* lits, int* store){
+    for(int i = 0; i < n_lits; i++){
+        store[i] = modelValue(S, internalLit(S, lits[i]));
+    }
+}
+
 //Returns 0 for true, 1 for false, 2 for unassigned, at level 0.
 int getConstantModel_Literal(Monosat::SimpSolver* S, int lit){
     Lit l = internalLit(S, lit);
@@ -2263,7 +2334,27 @@ int64_t getModel_BV(Monosat::SimpSolver* S, Monosat::BVTheorySolver<int64_t>* bv
 
 }
 
+void getModel_BVs(Monosat::SimpSolver* S, Monosat::BVTheorySolver<int64_t>* bv, int n_bvs, int* bvIDs,
+                  bool getMaximumValue, int64_t* store){
+    for(int i = 0; i < n_bvs; i++){
+        int bvID = internalBV(S, bvIDs[i]);
+        store[i] = getMaximumValue ? bv->getOverApprox(bvID) : bv->getUnderApprox(bvID);
+    }
+}
+
 //graph queries:
+int getModel_EdgeLiterals(Monosat::SimpSolver* S, Monosat::GraphTheorySolver<int64_t>* G, int store_length,
+                          int* store){
+    int n = nEdges(S, G);
+    if(store_length < n){
+        return n;
+    }
+    for(int i = 0; i < n; i++){
+        store[i] = modelValue(S, G->toSolver(mkLit(G->getEdges()[i].v)));
+    }
+    return n;
+}
+
 int getModel_Path_Nodes_Length(Monosat::SimpSolver* S, Monosat::GraphTheorySolver<int64_t>* G,
                                int reach_or_distance_literal){
     Lit l = internalLit(S, reach_or_distance_literal);
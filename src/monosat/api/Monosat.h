@@ -83,6 +83,9 @@ void deleteSolver(SolverPtr S);
 //Return true if the solver has not yet proven a the formula UNSAT
 bool ok(SolverPtr S);
 //If set, dump constraints to this file (as they are asserted in the solver)
+//The file is written from a background thread (unless the 'buffer-log' option is disabled); call flushFile to ensure
+//it is up to date. If the file name ends in .gz, it will be gzip compressed.
+//The resulting GNF can be replayed with readGNF (or by the monosat executable).
 void setOutputFile(SolverPtr S, const char* output);
 //Load a GNF, and run any embedded solve/optimize calls
 void readGNF(SolverPtr S, const char* filename);
@@ -236,6 +239,9 @@ int nLearnedClauses(SolverPtr S);
 int nBitvectors(SolverPtr S, BVTheoryPtr bv);
 
 bool addClause(SolverPtr S, int* lits, int n_lits);
+//Add n_clauses clauses, stored back to back in 'lits': clause i is lits[offsets[i]] .. lits[offsets[i+1]-1],
+//so 'offsets' must have n_clauses+1 (non-decreasing) entries. Returns false if the solver is then trivially unsatisfiable.
+bool addClauses(SolverPtr S, int* lits, int* offsets, int n_clauses);
 bool addUnitClause(SolverPtr S, int lit);
 bool addBinaryClause(SolverPtr S, int lit1, int lit2);
 bool addTertiaryClause(SolverPtr S, int lit1, int lit2, int lit3);
@@ -418,6 +424,14 @@ int getConstantModel_Literal(SolverPtr S, int lit);
 //Get an assignment to a bitvector in the model. The model may find a range of satisfying assignments to the bitvector;
 //If getMaximumValue is true, this function returns the maximum satisfying assignment to the bitvector in the model; else it returns the smallest.
 Weight getModel_BV(SolverPtr S, BVTheoryPtr bv, int bvID, bool getMaximumValue);
+//Bulk model queries, each equivalent to a sequence of the single queries above, but with only one call into the library.
+//For each of the n_lits literals (not variables!) in lits, store 0 for true, 1 for false, 2 for unassigned in store.
+void getModel_Literals(SolverPtr S, int n_lits, int* lits, int* store);
+//For each of the n_bvs bitvectors in bvIDs, store its assignment in the model (as getModel_BV) in store.
+void getModel_BVs(SolverPtr S, BVTheoryPtr bv, int n_bvs, int* bvIDs, bool getMaximumValue, Weight* store);
+//Store the model's assignment to each edge literal of the graph (0 for true, 1 for false, 2 for unassigned), in order of edge index.
+//Returns the number of edges in the graph; if store_length is less than that, nothing is stored.
+int getModel_EdgeLiterals(SolverPtr S, GraphTheorySolver_long G, int store_length, int* store);
 //graph queries:
 //maxflow_literal is the literal (not variable!) that is the atom for the maximum flow query
 Weight getModel_MaxFlow(SolverPtr S, GraphTheorySolver_long G, int maxflow_literal);
@@ -41,6 +41,7 @@
 #include "monosat/pb/PbSolver.h"
 #include "monosat/routing/FlowRouter.h"
 #include "monosat/api/Circuit.h"
+#include "monosat/api/APILog.h"
 #include <string>
 #include <cstdio>
 #include <ctime>
@@ -68,6 +69,7 @@ struct MonosatData {
     vec<Objective> optimization_objectives;
     Dimacs<StreamBuffer, SimpSolver>* parser = nullptr;
     FILE* outfile = nullptr;
+    Monosat::APILog* log = nullptr;//if set, outfile writes into this buffered log
     std::string args = "";
 
     MonosatData(SimpSolver* solver) : circuit(*solver){
@@ -625,6 +625,16 @@ JNIEXPORT jboolean JNICALL Java_monosat_MonosatJNI_addClause
     return false;
 }
 
+JNIEXPORT jboolean JNICALL Java_monosat_MonosatJNI_addClauses
+        (JNIEnv* env, jclass monosat_class, jlong solverPtr, jobject lits, jobject offsets, jint n_clauses) try{
+    SolverPtr solver = reinterpret_cast<SolverPtr>(solverPtr);
+    return jboolean(addClauses(solver, (int*) env->GetDirectBufferAddress(lits),
+                               (int*) env->GetDirectBufferAddress(offsets), n_clauses));
+}catch(...){
+    javaThrow(env);
+    return false;
+}
+
 
 JNIEXPORT jboolean JNICALL Java_monosat_MonosatJNI_addUnitClause
         (JNIEnv* env, jclass monosat_class, jlong solverPtr, jint lit) try{
@@ -1751,6 +1761,26 @@ JNIEXPORT jlong JNICALL Java_monosat_MonosatJNI_getModel_1BV
     return 0;
 }
 
+JNIEXPORT void JNICALL Java_monosat_MonosatJNI_getModel_1Literals
+        (JNIEnv* env, jclass monosat_class, jlong solverPtr, jint n_lits, jobject lits, jobject store) try{
+    SolverPtr solver = reinterpret_cast<SolverPtr>(solverPtr);
+    getModel_Literals(solver, n_lits, (int*) env->GetDirectBufferAddress(lits),
+                      (int*) env->GetDirectBufferAddress(store));
+}catch(...){
+    javaThrow(env);
+}
+
+JNIEXPORT void JNICALL Java_monosat_MonosatJNI_getModel_1BVs
+        (JNIEnv* env, jclass monosat_class, jlong solverPtr, jlong bitvectorPtr, jint n_bvs, jobject bvIDs,
+         jboolean getMaximumValue, jobject store) try{
+    SolverPtr solver = reinterpret_cast<SolverPtr>(solverPtr);
+    BVTheoryPtr bv = reinterpret_cast<BVTheoryPtr>(bitvectorPtr);
+    getModel_BVs(solver, bv, n_bvs, (int*) env->GetDirectBufferAddress(bvIDs), getMaximumValue,
+                 (int64_t*) env->GetDirectBufferAddress(store));
+}catch(...){
+    javaThrow(env);
+}
+
 
 JNIEXPORT jlong JNICALL Java_monosat_MonosatJNI_getModel_1MaxFlow
         (JNIEnv* env, jclass monosat_class, jlong solverPtr, jlong graphPtr, jint maxflow_literal) try{
@@ -1843,6 +1873,16 @@ JNIEXPORT jint JNICALL Java_monosat_MonosatJNI_getModel_1Path_1EdgeLits
     return 0;
 }
 
+JNIEXPORT jint JNICALL Java_monosat_MonosatJNI_getModel_1EdgeLiterals
+        (JNIEnv* env, jclass monosat_class, jlong solverPtr, jlong graphPtr, jint store_length, jobject store) try{
+    SolverPtr solver = reinterpret_cast<SolverPtr>(solverPtr);
+    GraphTheorySolver_long graph = reinterpret_cast<GraphTheorySolver_long>(graphPtr);
+    return jint(getModel_EdgeLiterals(solver, graph, store_length, (int*) env->GetDirectBufferAddress(store)));
+}catch(...){
+    javaThrow(env);
+    return 0;
+}
+
 //Circuit interface
 
 
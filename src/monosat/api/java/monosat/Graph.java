@@ -570,6 +570,26 @@ public final class Graph {
     return Collections.unmodifiableList(all_edges);
   }
 
+  /**
+   * Query the model for the values of all the edge literals in this graph at once. This is
+   * equivalent to calling possibleValue() on the literal of each edge, but makes only one call into
+   * the native library.
+   *
+   * @return A list containing, for each edge (in the order of getAllEdges()), the value of its
+   *     literal in the model, or an empty Optional if it is unassigned.
+   */
+  public List<Optional<Boolean>> getEdgeValues() {
+    int n = all_edges.size();
+    IntBuffer store = solver.getBuffer(0, n);
+    int sz = MonosatJNI.getModel_EdgeLiterals(solver.getSolverPtr(), graphPtr, n, store);
+    assert (sz == n);
+    ArrayList<Optional<Boolean>> values = new ArrayList<>(n);
+    for (int i = 0; i < n; i++) {
+      values.add(Solver.LBool.toLbool(store.get(i)).toOpt());
+    }
+    return values;
+  }
+
   /**
    * Return an unmodifiable view of all the directed edges incident to the node 'from'.
    *
@@ -22,6 +22,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 package monosat;
 
 import java.nio.IntBuffer;
+import java.nio.LongBuffer;
 import java.util.Vector;
 
 /**
@@ -263,6 +264,11 @@ final class MonosatJNI { // package level access specifier
 
   public static native boolean addClause(long solverPtr, IntBuffer lits, int n_lits);
 
+  // Add n_clauses clauses, stored back to back in lits: clause i is lits[offsets[i]] ..
+  // lits[offsets[i+1]-1], so offsets must have n_clauses+1 entries.
+  public static native boolean addClauses(
+      long solverPtr, IntBuffer lits, IntBuffer offsets, int n_clauses);
+
   public static native boolean addUnitClause(long solverPtr, int lit);
 
   public static native boolean addBinaryClause(long solverPtr, int lit1, int lit2);
@@ -570,6 +576,26 @@ final class MonosatJNI { // package level access specifier
   public static native long getModel_BV(
       long solverPtr, long bvPtr, int bvID, boolean getMaximumValue);
 
+  // Bulk model queries, each equivalent to a sequence of the single queries above, with only one
+  // call into the native library.
+  // For each of the n_lits literals in lits, store 0 for true, 1 for false, 2 for unassigned.
+  public static native void getModel_Literals(
+      long solverPtr, int n_lits, IntBuffer lits, IntBuffer store);
+
+  // For each of the n_bvs bitvectors in bvIDs, store its assignment in the model.
+  public static native void getModel_BVs(
+      long solverPtr,
+      long bvPtr,
+      int n_bvs,
+      IntBuffer bvIDs,
+      boolean getMaximumValue,
+      LongBuffer store);
+
+  // Store the model's assignment to each edge literal of the graph, in order of edge index.
+  // Returns the number of edges; if that is more than store_length, nothing is stored.
+  public static native int getModel_EdgeLiterals(
+      long solverPtr, long graphPtr, int store_length, IntBuffer store);
+
   // graph queries:
   // maxflow_literal is the literal (not variable!) that is the atom for the maximum flow query
   public static native long getModel_MaxFlow(long solverPtr, long graphPtr, int maxflow_literal);
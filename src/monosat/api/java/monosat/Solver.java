@@ -26,6 +26,7 @@ import java.io.IOException;
 import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
 import java.nio.IntBuffer;
+import java.nio.LongBuffer;
 import java.util.*;
 import java.util.logging.Logger;
 
@@ -107,6 +108,10 @@ public final class Solver implements Closeable {
   private IntBuffer ints1;
   /** Used internally to manage byte buffers for calls to the C api */
   private IntBuffer ints2;
+  /** Used internally to manage byte buffers for calls to the C api */
+  private int long_buffer_size = 0;
+  /** Used internally to manage byte buffers for calls to the C api */
+  private LongBuffer longs;
 
   /** Instantiate a new Solver, with default settings. */
   public Solver() {
@@ -464,6 +469,25 @@ public final class Solver implements Closeable {
     throw new IllegalArgumentException("BufferN must be between 0 and 2");
   }
 
+  /**
+   * Get a long direct buffer for passing arguments to and from the native library.
+   *
+   * @param minsize The minimum size that the buffer must have allocated (must be >=0).
+   * @return A direct long buffer of sufficient size to hold minsize longs.
+   */
+  protected LongBuffer getLongBuffer(int minsize) {
+    if (minsize < 0) {
+      throw new IllegalArgumentException("minsize must be >=0");
+    }
+    if (longs == null || minsize >= long_buffer_size) {
+      long_buffer_size = Math.max(1024, minsize * 2);
+      ByteBuffer b = ByteBuffer.allocateDirect(long_buffer_size * 8); // 8 bytes per long
+      b.order(ByteOrder.LITTLE_ENDIAN);
+      longs = b.asLongBuffer();
+    }
+    return longs;
+  }
+
   /** Instantiate the bitvector theory in this solver. */
   private void initBV() {
     assert (bvPtr == 0);
@@ -898,6 +922,34 @@ public final class Solver implements Closeable {
     return MonosatJNI.addClause(getSolverPtr(), getLitBuffer(args, 1), args.size());
   }
 
+  /**
+   * Add many clauses to the solver at once. This is equivalent to calling addClause() on each
+   * clause, but makes only one call into the native library.
+   *
+   * @param clauses The clauses to add to the solver.
+   * @return False if, after adding the clauses, the solver is trivially unsatisfiable; true
+   *     otherwise.
+   */
+  public boolean addClauses(Collection<? extends Collection<Lit>> clauses) {
+    int n_lits = 0;
+    for (Collection<Lit> clause : clauses) {
+      validate(clause);
+      n_lits += clause.size();
+    }
+    IntBuffer lits = getBuffer(1, n_lits);
+    IntBuffer offsets = getBuffer(2, clauses.size() + 1);
+    int index = 0;
+    int clause_index = 0;
+    offsets.put(0, 0);
+    for (Collection<Lit> clause : clauses) {
+      for (Lit l : clause) {
+        lits.put(index++, l.l);
+      }
+      offsets.put(++clause_index, index);
+    }
+    return MonosatJNI.addClauses(getSolverPtr(), lits, offsets, clauses.size());
+  }
+
   /**
    * Either find a satisfying solution to the constraints in te formula, or prove the formula to be
    * unsatisfiable.
@@ -1860,6 +1912,51 @@ public final class Solver implements Closeable {
     return MonosatJNI.hasModel(getSolverPtr());
   }
 
+  /**
+   * Query the model for the values of many literals at once. This is equivalent to calling
+   * possibleValue() on each literal, but makes only one call into the native library.
+   *
+   * @param lits The literals to query.
+   * @return A list containing, for each literal (in order), its value in the model, or an empty
+   *     Optional if it is unassigned.
+   */
+  public List<Optional<Boolean>> possibleValues(Collection<Lit> lits) {
+    validate(lits);
+    IntBuffer lit_buffer = getLitBuffer(lits, 0);
+    IntBuffer store = getBuffer(1, lits.size());
+    MonosatJNI.getModel_Literals(getSolverPtr(), lits.size(), lit_buffer, store);
+    ArrayList<Optional<Boolean>> values = new ArrayList<>(lits.size());
+    for (int i = 0; i < lits.size(); i++) {
+      values.add(LBool.toLbool(store.get(i)).toOpt());
+    }
+    return values;
+  }
+
+  /**
+   * Query the model for the values of many bitvectors at once. This is equivalent to calling
+   * value(getMaximumValue) on each bitvector, but makes only one call into the native library.
+   *
+   * @param bvs The bitvectors to query.
+   * @param getMaximumValue If true, return the largest satisfying value of each bitvector in the
+   *     model (else, the smallest).
+   * @return An array containing the value of each bitvector, in order.
+   * @throws NoModelException If the solver does not have a satisfying assignment.
+   */
+  public long[] values(Collection<BitVector> bvs, boolean getMaximumValue) {
+    if (!hasModel()) {
+      throw new NoModelException(
+          "Solver has no model (this may indicate either that the solve() has not yet been called, or that the most recent call to solve() returned a value other than true, or that a constraint was added into the solver after the last call to solve()).");
+    }
+    validateBV(bvs);
+    IntBuffer bv_buffer = getBVBuffer(bvs, 0);
+    LongBuffer store = getLongBuffer(bvs.size());
+    MonosatJNI.getModel_BVs(getSolverPtr(), bvPtr, bvs.size(), bv_buffer, getMaximumValue, store);
+    long[] values = new long[bvs.size()];
+    store.get(values, 0, values.length);
+    store.rewind();
+    return values;
+  }
+
   /**
    * Return true if the solver has not yet proven its constraints to be UNSAT. If this returns
    * false, then all future calls to 'solve' will return false.
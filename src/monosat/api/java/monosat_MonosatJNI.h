@@ -479,6 +479,14 @@ JNIEXPORT jint JNICALL Java_monosat_MonosatJNI_nBitvectors
 JNIEXPORT jboolean JNICALL Java_monosat_MonosatJNI_addClause
         (JNIEnv*, jclass, jlong, jobject, jint);
 
+/*
+ * Class:     monosat_MonosatJNI
+ * Method:    addClauses
+ * Signature: (JLjava/nio/IntBuffer;Ljava/nio/IntBuffer;I)Z
+ */
+JNIEXPORT jboolean JNICALL Java_monosat_MonosatJNI_addClauses
+        (JNIEnv*, jclass, jlong, jobject, jobject, jint);
+
 /*
  * Class:     monosat_MonosatJNI
  * Method:    addUnitClause
@@ -1343,6 +1351,30 @@ JNIEXPORT jint JNICALL Java_monosat_MonosatJNI_getConstantModel_1Literal
 JNIEXPORT jlong JNICALL Java_monosat_MonosatJNI_getModel_1BV
         (JNIEnv*, jclass, jlong, jlong, jint, jboolean);
 
+/*
+ * Class:     monosat_MonosatJNI
+ * Method:    getModel_Literals
+ * Signature: (JILjava/nio/IntBuffer;Ljava/nio/IntBuffer;)V
+ */
+JNIEXPORT void JNICALL Java_monosat_MonosatJNI_getModel_1Literals
+        (JNIEnv*, jclass, jlong, jint, jobject, jobject);
+
+/*
+ * Class:     monosat_MonosatJNI
+ * Method:    getModel_BVs
+ * Signature: (JJILjava/nio/IntBuffer;ZLjava/nio/LongBuffer;)V
+ */
+JNIEXPORT void JNICALL Java_monosat_MonosatJNI_getModel_1BVs
+        (JNIEnv*, jclass, jlong, jlong, jint, jobject, jboolean, jobject);
+
+/*
+ * Class:     monosat_MonosatJNI
+ * Method:    getModel_EdgeLiterals
+ * Signature: (JJILjava/nio/IntBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_monosat_MonosatJNI_getModel_1EdgeLiterals
+        (JNIEnv*, jclass, jlong, jlong, jint, jobject);
+
 /*
  * Class:     monosat_MonosatJNI
  * Method:    getModel_MaxFlow
@@ -27,6 +27,8 @@ import java.io.File;
 import java.io.IOException;
 import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.List;
+import java.util.Optional;
 
 import static org.junit.Assert.*;
 
@@ -212,6 +214,63 @@ public class SolverTest {
     assertTrue(s2.ok());
  }
 
+  @Test
+  public void testAddClauses() {
+    monosat.Solver s = new monosat.Solver();
+    Lit a = new Lit(s);
+    Lit b = new Lit(s);
+    Lit c = new Lit(s);
+    assertTrue(
+        s.addClauses(
+            Arrays.asList(Arrays.asList(a, b), Arrays.asList(a.not(), c), Arrays.asList(c.not()))));
+    assertTrue(s.addClauses(new ArrayList<List<Lit>>()));
+    assertTrue(s.solve());
+    assertTrue(b.value());
+    assertFalse(c.value());
+    assertFalse(s.addClauses(Arrays.asList(Arrays.asList(a, b), new ArrayList<Lit>())));
+    assertFalse(s.solve());
+  }
+
+  @Test
+  public void testBulkModelQueries() {
+    monosat.Solver s = new monosat.Solver();
+    ArrayList<Lit> lits = new ArrayList<>();
+    for (int i = 0; i < 10; i++) {
+      Lit l = new Lit(s);
+      lits.add(i % 2 == 0 ? l : l.not());
+    }
+    s.assertTrue(lits.get(0));
+    s.assertFalse(lits.get(1));
+    BitVector a = new BitVector(s, 4);
+    BitVector b = new BitVector(s, 4);
+    s.assertTrue(a.eq(3));
+    s.assertTrue(b.eq(a.add(2)));
+    Graph g = new Graph(s);
+    for (int i = 0; i < 4; i++) {
+      g.addNode();
+    }
+    g.addEdge(0, 1);
+    g.addEdge(1, 2);
+    g.addEdge(2, 3);
+    s.assertTrue(g.reaches(0, 3));
+    assertTrue(s.solve());
+
+    ArrayList<Lit> all = new ArrayList<>(lits);
+    all.add(Lit.True);
+    all.add(Lit.False);
+    List<Optional<Boolean>> values = s.possibleValues(all);
+    assertEquals(all.size(), values.size());
+    for (int i = 0; i < all.size(); i++) {
+      assertEquals(all.get(i).possibleValue(), values.get(i));
+    }
+    assertArrayEquals(new long[] {3, 5}, s.values(Arrays.asList(a, b), false));
+    List<Optional<Boolean>> edge_values = g.getEdgeValues();
+    assertEquals(3, edge_values.size());
+    for (Optional<Boolean> v : edge_values) {
+      assertEquals(Optional.of(true), v);
+    }
+  }
+
   @Test
   public void version() {
     String version = monosat.Solver.getVersion();
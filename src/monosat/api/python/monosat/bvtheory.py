@@ -17,7 +17,10 @@
 # DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
 # OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
-import collections
+try:
+    from collections.abc import Iterable
+except ImportError:  # Python 2
+    from collections import Iterable
 import monosat.monosat_c
 import sys
 from monosat.logic import *
@@ -141,6 +144,12 @@ def _checkBVs(bvs):
             )
 
 
+# Returns the values of the given BitVectors in the most recent model (as BitVector.value()), querying the solver only once.
+# If getMaximumValue is true, returns the largest satisfying value of each bitvector in the model, else the smallest.
+def getBVValues(bvs, getMaximumValue=False):
+    return Monosat().getModel_BVs([bv.getID() for bv in bvs], getMaximumValue)
+
+
 class BitVector:
 
     def __init__(self, mgr, width=None, op=None, args=None):
@@ -151,7 +160,7 @@ class BitVector:
             op = width
             width = mgr
             mgr = BVManager()
-        elif isinstance(mgr, collections.Iterable):
+        elif isinstance(mgr, Iterable):
             assigned_bits = list(mgr)
             mgr = BVManager()
             # Build this bitvector from a list of elements
@@ -22,6 +22,7 @@ import monosat.monosat_c
 import sys
 from monosat.bvtheory import BitVector
 from monosat.logic import *
+from monosat.logic import _model_values
 from monosat.manager import Manager
 
 debug = False
@@ -244,6 +245,11 @@ class Graph:
         else:
             return self.alledges
 
+    # Returns the values of all the edge variables of this graph in the most recent model (as Var.value(), in the
+    # order of getAllEdges()), querying the solver only once.
+    def getEdgeValues(self):
+        return [_model_values[v] for v in self._monosat.getModel_EdgeLiterals(self.graph)]
+
     # returns the variable corresponding to the backward (directed) edge of the edge
     # corresponding to this variable, if such an edge exists. Returns None otherwise.
     def backEdgeVar(self, v):
@@ -22,6 +22,7 @@ from __future__ import print_function
 # Python interface to MonoSAT
 # Includes _optional_ support for cython, otherwise falling back on ctypes
 
+import array
 import os
 import platform
 from monosat.singleton import Singleton
@@ -306,6 +307,14 @@ class Monosat(metaclass=Singleton):
             self.monosat_c.addClause.argtypes = [c_solver_p, c_literal_p, c_int]
             self.monosat_c.addClause.restype = c_bool
 
+            self.monosat_c.addClauses.argtypes = [
+                c_solver_p,
+                c_literal_p,
+                c_int_p,
+                c_int,
+            ]
+            self.monosat_c.addClauses.restype = c_bool
+
             self.monosat_c.addUnitClause.argtypes = [c_solver_p, c_literal]
             self.monosat_c.addUnitClause.restype = c_bool
 
@@ -834,6 +843,30 @@ class Monosat(metaclass=Singleton):
             self.monosat_c.getModel_BV.argtypes = [c_solver_p, c_bv_p, c_bvID, c_bool]
             self.monosat_c.getModel_BV.restype = c_int64
 
+            self.monosat_c.getModel_Literals.argtypes = [
+                c_solver_p,
+                c_int,
+                c_literal_p,
+                c_int_p,
+            ]
+
+            self.monosat_c.getModel_BVs.argtypes = [
+                c_solver_p,
+                c_bv_p,
+                c_int,
+                c_bvID_p,
+                c_bool,
+                c_long_p,
+            ]
+
+            self.monosat_c.getModel_EdgeLiterals.argtypes = [
+                c_solver_p,
+                c_graph_p,
+                c_int,
+                c_int_p,
+            ]
+            self.monosat_c.getModel_EdgeLiterals.restype = c_int
+
             self.monosat_c.getModel_MaxFlow.argtypes = [
                 c_solver_p,
                 c_graph_p,
@@ -1128,6 +1161,43 @@ class Monosat(metaclass=Singleton):
             lp = self.getIntArray(clause)
             self.monosat_c.addClause(self.solver._ptr, lp, len(clause))
 
+    # Add many clauses in one call, in compressed sparse row form: clause i is lits[offsets[i]:offsets[i+1]], so offsets
+    # has one more entry than there are clauses. lits and offsets may be lists, or buffers of C ints (such as
+    # array.array('i') or int32 numpy arrays), which are passed to the library without copying.
+    # Returns false if the solver is then trivially unsatisfiable.
+    def addClauses(self, lits, offsets):
+        n_clauses = len(offsets) - 1
+        if n_clauses <= 0:
+            n_clauses = 0
+            offsets = [0]
+        elif offsets[0] < 0 or offsets[n_clauses] > len(lits):
+            raise RuntimeError(
+                "Clause offsets out of range (%d to %d, with %d literals)"
+                % (offsets[0], offsets[n_clauses], len(lits))
+            )
+        if len(lits) > 0:
+            self.checkLit(min(lits))
+            self.checkLit(max(lits))
+        return self.monosat_c.addClauses(
+            self.solver._ptr,
+            self._intBuffer(lits),
+            self._intBuffer(offsets),
+            n_clauses,
+        )
+
+    # Returns nums as a buffer of C ints that can be passed to the library: buffers of C ints are passed as they are,
+    # anything else is copied.
+    def _intBuffer(self, nums):
+        try:
+            m = memoryview(nums)
+        except TypeError:
+            m = None
+        if m is not None and m.format == "i" and m.ndim == 1 and not m.readonly and m.c_contiguous:
+            return nums if use_cython else (c_int * len(m)).from_buffer(nums)
+        if use_cython:
+            return array.array("i", nums)
+        return (c_int * len(nums))(*nums)
+
     def clearOptimizationObjectives(self):
         self.monosat_c.clearOptimizationObjectives(self.solver._ptr)
 
@@ -1840,6 +1910,65 @@ class Monosat(metaclass=Singleton):
             c_bool(getMaximumValue),
         )
 
+    # Bulk model queries: each returns a list of the values that the corresponding single query above would return for
+    # each element of its argument, but with only one call into the library.
+    def getModel_Literals(self, lits):
+        n = len(lits)
+        if n > 0 and min(lits) < 0:
+            raise RuntimeError("Bad literal %d" % (min(lits)))
+        if use_cython:
+            store = array.array("i", bytes(4 * n))
+            self.monosat_c.getModel_Literals(
+                self.solver._ptr, n, array.array("i", lits), store
+            )
+            return store.tolist()
+        else:
+            store = (c_int * n)()
+            self.monosat_c.getModel_Literals(
+                self.solver._ptr, n, (c_int * n)(*lits), store
+            )
+            return store[:]
+
+    def getModel_BVs(self, bvIDs, getMaximumValue=False):
+        n = len(bvIDs)
+        if n > 0:
+            self.checkBV(min(bvIDs))
+            self.checkBV(max(bvIDs))
+        if use_cython:
+            store = array.array("q", bytes(8 * n))
+            self.monosat_c.getModel_BVs(
+                self.solver._ptr,
+                self.solver.bvtheory,
+                n,
+                array.array("i", bvIDs),
+                getMaximumValue,
+                store,
+            )
+            return store.tolist()
+        else:
+            store = (c_int64 * n)()
+            self.monosat_c.getModel_BVs(
+                self.solver._ptr,
+                self.solver.bvtheory,
+                n,
+                (c_int * n)(*bvIDs),
+                c_bool(getMaximumValue),
+                store,
+            )
+            return store[:]
+
+    # Returns the model's values of all the edge literals of the graph, in order of edge index
+    def getModel_EdgeLiterals(self, graph):
+        n = self.nEdges(graph)
+        if use_cython:
+            store = array.array("i", bytes(4 * n))
+        else:
+            store = (c_int * n)()
+        l = self.monosat_c.getModel_EdgeLiterals(self.solver._ptr, graph, n, store)
+        if l != n:
+            raise RuntimeError("Error reading edge model")
+        return store.tolist() if use_cython else store[:]
+
     def getModel_MaxFlow(self, graph, flowlit):
         self.checkLit(flowlit)
         return self.monosat_c.getModel_MaxFlow(self.solver._ptr, graph, flowlit)
@@ -86,6 +86,8 @@ cdef extern from "monosat/api/Monosat.h":
 
     bint addClause(SolverPtr S, int* lits, int n_lits)
 
+    bint addClauses(SolverPtr S, int* lits, int* offsets, int n_clauses)
+
     bint addUnitClause(SolverPtr S, int lit)
 
     bint addBinaryClause(SolverPtr S, int lit1, int lit2)
@@ -260,6 +262,12 @@ cdef extern from "monosat/api/Monosat.h":
 
     Weight getModel_BV(SolverPtr S, BVTheoryPtr bv, int bvID, bint getMaximumValue)
 
+    void getModel_Literals(SolverPtr S, int n_lits, int* lits, int* store)
+
+    void getModel_BVs(SolverPtr S, BVTheoryPtr bv, int n_bvs, int* bvIDs, bint getMaximumValue, Weight* store)
+
+    int getModel_EdgeLiterals(SolverPtr S, GraphTheorySolver_long G, int store_length, int* store)
+
     Weight getModel_MaxFlow(SolverPtr S, GraphTheorySolver_long G, int maxflow_literal)
 
     Weight getModel_EdgeFlow(SolverPtr S, GraphTheorySolver_long G, int maxflow_literal, int edgeLit)
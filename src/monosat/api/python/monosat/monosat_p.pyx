@@ -23,6 +23,7 @@ from monosat_header cimport acyclic_undirected as _acyclic_undirected_monosat
 from monosat_header cimport addBinaryClause as _addBinaryClause_monosat
 from monosat_header cimport addBinaryClauses as _addBinaryClauses_monosat
 from monosat_header cimport addClause as _addClause_monosat
+from monosat_header cimport addClauses as _addClauses_monosat
 from monosat_header cimport addRoutingNet as _addRoutingNet_monosat
 from monosat_header cimport addTertiaryClause as _addTertiaryClause_monosat
 from monosat_header cimport addUnitClause as _addUnitClause_monosat
@@ -68,8 +69,11 @@ from monosat_header cimport getDecisionPolarity as _getDecisionPolarity_monosat
 from monosat_header cimport getDecisionPriority as _getDecisionPriority_monosat
 from monosat_header cimport getModel_AcyclicEdgeFlow as _getModel_AcyclicEdgeFlow_monosat
 from monosat_header cimport getModel_BV as _getModel_BV_monosat
+from monosat_header cimport getModel_BVs as _getModel_BVs_monosat
 from monosat_header cimport getModel_EdgeFlow as _getModel_EdgeFlow_monosat
+from monosat_header cimport getModel_EdgeLiterals as _getModel_EdgeLiterals_monosat
 from monosat_header cimport getModel_Literal as _getModel_Literal_monosat
+from monosat_header cimport getModel_Literals as _getModel_Literals_monosat
 from monosat_header cimport getModel_MaxFlow as _getModel_MaxFlow_monosat
 from monosat_header cimport getModel_MinimumSpanningTreeWeight as _getModel_MinimumSpanningTreeWeight_monosat
 from monosat_header cimport getModel_Path_EdgeLits as _getModel_Path_EdgeLits_monosat
@@ -201,6 +205,20 @@ def addClause( S ,  lits ,  n_lits ):
     py_result = <bint>_r
     return py_result
 
+def addClauses( S ,  lits ,  offsets ,  n_clauses ):
+    """Cython signature: bint addClauses(void* S, int* lits, int* offsets, int n_clauses)
+    lits and offsets may be any writable buffers of C ints (such as array.array('i') or numpy arrays), which are
+    passed to the library without copying."""
+
+    assert isinstance(n_clauses, (int, long)), 'arg n_clauses wrong type'
+    cdef int[::1] _lits = lits
+    cdef int[::1] _offsets = offsets
+    assert _offsets.shape[0] > n_clauses, 'arg offsets too short'
+    assert n_clauses == 0 or _lits.shape[0] >= _offsets[n_clauses], 'arg lits too short'
+    cdef bint _r = _addClauses_monosat((<void*>pycapsule.PyCapsule_GetPointer(S,NULL)), (&_lits[0] if _lits.shape[0] > 0 else NULL), (&_offsets[0]), (<int>n_clauses))
+    py_result = <bint>_r
+    return py_result
+
 def addRoutingNet( S ,  G ,  router ,  disabledEdge ,  n_members ,  edge_lits ,  reach_lits ):
     """Cython signature: void addRoutingNet(void* S, void* G, void* router, int disabledEdge, int n_members, int* edge_lits, int* reach_lits)"""
 
@@ -737,6 +755,19 @@ def getModel_BV( S ,  bv ,  bvID ,  getMaximumValue ):
     py_result = <int64_t>_r
     return py_result
 
+def getModel_BVs( S ,  bv ,  n_bvs ,  bvIDs ,  getMaximumValue ,  store ):
+    """Cython signature: void getModel_BVs(void* S, void* bv, int n_bvs, int* bvIDs, bint getMaximumValue, int64_t* store)
+    bvIDs and store may be any writable buffers of C ints and int64_ts (such as array.array('i') and array.array('q'),
+    or numpy arrays), which are passed to the library without copying."""
+
+    assert isinstance(n_bvs, (int, long)), 'arg n_bvs wrong type'
+    assert isinstance(getMaximumValue, (int, long)), 'arg getMaximumValue wrong type'
+    cdef int[::1] _bvIDs = bvIDs
+    cdef int64_t[::1] _store = store
+    assert _bvIDs.shape[0] >= n_bvs and _store.shape[0] >= n_bvs, 'arg bvIDs or store too short'
+    if n_bvs > 0:
+        _getModel_BVs_monosat((<void*>pycapsule.PyCapsule_GetPointer(S,NULL)), (<void*>pycapsule.PyCapsule_GetPointer(bv,NULL)), (<int>n_bvs), (&_bvIDs[0]), (<bint>getMaximumValue), (&_store[0]))
+
 def getModel_EdgeFlow( S ,  G ,  maxflow_literal ,  edgeLit ):
     """Cython signature: int64_t getModel_EdgeFlow(void* S, void* G, int maxflow_literal, int edgeLit)"""
 
@@ -751,6 +782,18 @@ def getModel_EdgeFlow( S ,  G ,  maxflow_literal ,  edgeLit ):
     py_result = <int64_t>_r
     return py_result
 
+def getModel_EdgeLiterals( S ,  G ,  store_length ,  store ):
+    """Cython signature: int getModel_EdgeLiterals(void* S, void* G, int store_length, int* store)
+    store may be any writable buffer of C ints (such as array.array('i') or a numpy array), which is passed to the
+    library without copying."""
+
+    assert isinstance(store_length,(int,long)), 'arg store_length wrong type'
+    cdef int[::1] _store = store
+    assert _store.shape[0] >= store_length, 'arg store too short'
+    cdef int _r = _getModel_EdgeLiterals_monosat((<void*>pycapsule.PyCapsule_GetPointer(S,NULL)), (<void*>pycapsule.PyCapsule_GetPointer(G,NULL)), (<int>store_length), (&_store[0] if store_length > 0 else NULL))
+    py_result = <int>_r
+    return py_result
+
 def getModel_Literal( S ,  lit ):
     """Cython signature: int getModel_Literal(void* S, int lit)"""
 
@@ -761,6 +804,18 @@ def getModel_Literal( S ,  lit ):
     py_result = <int>_r
     return py_result
 
+def getModel_Literals( S ,  n_lits ,  lits ,  store ):
+    """Cython signature: void getModel_Literals(void* S, int n_lits, int* lits, int* store)
+    lits and store may be any writable buffers of C ints (such as array.array('i') or numpy arrays), which are
+    passed to the library without copying."""
+
+    assert isinstance(n_lits, (int, long)), 'arg n_lits wrong type'
+    cdef int[::1] _lits = lits
+    cdef int[::1] _store = store
+    assert _lits.shape[0] >= n_lits and _store.shape[0] >= n_lits, 'arg lits or store too short'
+    if n_lits > 0:
+        _getModel_Literals_monosat((<void*>pycapsule.PyCapsule_GetPointer(S,NULL)), (<int>n_lits), (&_lits[0]), (&_store[0]))
+
 def getModel_MaxFlow( S ,  G ,  maxflow_literal ):
     """Cython signature: int64_t getModel_MaxFlow(void* S, void* G, int maxflow_literal)"""
 
@@ -3,3 +3,10 @@ import tests
 import tests.test_logic
 import tests.test_graph
 import tests.test_output
+import tests.test_amo
+import tests.test_optimize
+import tests.test_assumptions
+import tests.test_search
+import tests.test_graph_preprocess
+import tests.test_model
+import tests.test_clauses
@@ -0,0 +1,82 @@
+import itertools
+import random
+import unittest
+
+import monosat
+
+# Options are global to the library, so every solver in this file sets all of the amo options explicitly.
+DEFAULT = "-amo-merge-limit=1000 -clausify-amo=30"
+NO_MERGE = "-amo-merge-limit=0 -clausify-amo=30"
+# keep every group in the amo theory, so that merged groups are actually enforced by the theory
+THEORY_ONLY = "-amo-merge-limit=1000 -clausify-amo=0"
+THEORY_NO_MERGE = "-amo-merge-limit=0 -clausify-amo=0"
+# only examine one candidate literal per group while merging, and clausify everything that is left
+MERGE_LIMITED = "-amo-merge-limit=1 -clausify-amo=1000"
+
+
+def brute_force(n, groups, clauses, assumptions):
+    for assignment in itertools.product([False, True], repeat=n):
+        if any(not assignment[v] for v in assumptions):
+            continue
+        if any(sum(assignment[v] for v in g) > 1 for g in groups):
+            continue
+        if all(any(assignment[v] != neg for (v, neg) in c) for c in clauses):
+            return True
+    return False
+
+
+class TestAMO(unittest.TestCase):
+    def solve(self, args, n, groups, clauses, assumptions):
+        monosat.Monosat().newSolver(args)
+        vars = [monosat.Var() for _ in range(n)]
+        for g in groups:
+            # (monosat.AssertAtMostOne introduces fresh variables for each group, which would hide the overlaps)
+            monosat.Monosat().AssertAtMostOne([vars[v].getLit() for v in g])
+        for c in clauses:
+            monosat.AssertClause([monosat.Not(vars[v]) if neg else vars[v] for (v, neg) in c])
+        result = monosat.Solve([vars[v] for v in assumptions])
+        if result:
+            for g in groups:
+                self.assertLessEqual(sum(1 for v in g if vars[v].value()), 1)
+            for v in assumptions:
+                self.assertTrue(vars[v].value())
+        return result
+
+    def test_overlapping_groups(self):
+        # three pairwise at-most-one constraints over a, b, c form a single clique that can be merged
+        groups = [[0, 1], [1, 2], [0, 2], [2, 3]]
+        for args in [DEFAULT, NO_MERGE, THEORY_ONLY, THEORY_NO_MERGE, MERGE_LIMITED]:
+            self.assertTrue(self.solve(args, 4, groups, [[(0, False), (1, False), (2, False)]], []), args)
+            self.assertFalse(self.solve(args, 4, groups, [], [0, 1]), args)
+            self.assertFalse(self.solve(args, 4, groups, [], [1, 2]), args)
+            self.assertFalse(self.solve(args, 4, groups, [], [0, 2]), args)
+            self.assertTrue(self.solve(args, 4, groups, [], [0, 3]), args)
+            self.assertFalse(self.solve(args, 4, groups, [[(0, False), (1, False)]], [2]), args)
+
+    def test_group_past_merge_limit(self):
+        # a large group, overlapping with many small ones, so that merging stops at the limit and the remaining
+        # groups are clausified
+        n = 12
+        groups = [list(range(8))] + [[i, i + 1] for i in range(7, n - 1)] + [[0, i] for i in range(8, n)]
+        for args in [DEFAULT, NO_MERGE, THEORY_ONLY, MERGE_LIMITED]:
+            self.assertTrue(self.solve(args, n, groups, [], [0]), args)
+            self.assertFalse(self.solve(args, n, groups, [], [0, 9]), args)
+            self.assertFalse(self.solve(args, n, groups, [], [3, 5]), args)
+            self.assertTrue(self.solve(args, n, groups, [], [3, 9, 11]), args)
+            self.assertFalse(self.solve(args, n, groups, [], [9, 10]), args)
+
+    def test_merge_agrees_with_no_merge(self):
+        rnd = random.Random(1234)
+        for _ in range(40):
+            n = rnd.randint(4, 10)
+            groups = [rnd.sample(range(n), rnd.randint(2, min(n, 4))) for _ in range(rnd.randint(1, 8))]
+            clauses = [[(v, rnd.random() < 0.3) for v in rnd.sample(range(n), rnd.randint(1, 3))]
+                       for _ in range(rnd.randint(0, 5))]
+            assumptions = rnd.sample(range(n), rnd.randint(0, 2))
+            expect = brute_force(n, groups, clauses, assumptions)
+            for args in [DEFAULT, NO_MERGE, THEORY_ONLY, THEORY_NO_MERGE, MERGE_LIMITED]:
+                self.assertEqual(self.solve(args, n, groups, clauses, assumptions), expect, args)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,91 @@
+import random
+import unittest
+
+import monosat
+
+
+def build_instance(seed):
+    """A small random instance mixing graph and bitvector constraints.
+    Returns the atoms (literals) that assumptions are drawn from."""
+    rnd = random.Random(seed)
+    width = 4
+    n_nodes = 6
+    # a graph with constant edge weights, and one with bitvector edge weights (which can't be mixed in one graph)
+    graphs = [monosat.Graph(), monosat.Graph()]
+    for g in graphs:
+        for _ in range(n_nodes):
+            g.addNode()
+    bvs = [monosat.BitVector(width) for _ in range(3)]
+    edges = []
+    for _ in range(rnd.randint(6, 12)):
+        u, v = rnd.sample(range(n_nodes), 2)
+        if rnd.random() < 0.5:
+            edges.append(graphs[1].addEdge(u, v, rnd.choice(bvs)))
+        else:
+            edges.append(graphs[0].addEdge(u, v, rnd.randint(1, 4)))
+    atoms = list(edges)
+    for g in graphs:
+        for _ in range(2):
+            atoms.append(g.reaches(0, rnd.randint(1, n_nodes - 1)))
+        for _ in range(2):
+            atoms.append(g.distance_leq(0, rnd.randint(1, n_nodes - 1), rnd.randint(2, 9)))
+    for bv in bvs:
+        atoms.append(bv > rnd.randint(0, 8))
+        atoms.append(bv <= rnd.randint(4, 14))
+    atoms.append(bvs[0] + bvs[1] == bvs[2])
+    atoms.append(bvs[0] < bvs[1])
+    for _ in range(rnd.randint(0, 4)):
+        monosat.AssertOr(*[monosat.Not(a) if rnd.random() < 0.5 else a for a in rnd.sample(atoms, 2)])
+    return atoms
+
+
+def assumption_sequence(seed, n_atoms, length):
+    """A sequence of assumption lists (as (atom index, sign) pairs), each of which keeps a random prefix of the
+    previous one, and replaces the rest."""
+    rnd = random.Random(seed)
+    sequence = []
+    previous = []
+    for _ in range(length):
+        keep = rnd.randint(0, len(previous))
+        assumptions = previous[:keep]
+        used = set(i for (i, sign) in assumptions)
+        for i in rnd.sample(range(n_atoms), rnd.randint(0, 5)):
+            if i not in used:
+                assumptions.append((i, rnd.random() < 0.5))
+                used.add(i)
+        sequence.append(assumptions)
+        previous = assumptions
+    return sequence
+
+
+def to_lits(atoms, assumptions):
+    return [monosat.Not(atoms[i]) if sign else atoms[i] for (i, sign) in assumptions]
+
+
+def solve_incrementally(args, seed, sequence):
+    monosat.Monosat().newSolver(args)
+    atoms = build_instance(seed)
+    return [monosat.Solve(to_lits(atoms, assumptions)) for assumptions in sequence]
+
+
+def solve_fresh(args, seed, sequence):
+    results = []
+    for assumptions in sequence:
+        monosat.Monosat().newSolver(args)
+        atoms = build_instance(seed)
+        results.append(monosat.Solve(to_lits(atoms, assumptions)))
+    return results
+
+
+class TestAssumptions(unittest.TestCase):
+    def test_changing_assumption_suffixes(self):
+        # Options are global to the library, so every solver here sets them explicitly.
+        for args in ["-no-theory-prop-during-assumps", "-theory-prop-during-assumps"]:
+            for seed in range(12):
+                sequence = assumption_sequence(seed + 100, 21, 12)
+                expect = solve_fresh(args, seed, sequence)
+                self.assertEqual(solve_incrementally(args, seed, sequence), expect, (args, seed))
+
+
+if __name__ == "__main__":
+    unittest.main()
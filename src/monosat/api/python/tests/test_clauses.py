@@ -0,0 +1,58 @@
+import array
+import random
+import unittest
+
+import monosat
+
+
+def random_clauses(rnd, vars, n_clauses):
+    return [[v if rnd.random() < 0.5 else monosat.Not(v) for v in rnd.sample(vars, rnd.randint(1, 4))]
+            for _ in range(n_clauses)]
+
+
+class TestClauses(unittest.TestCase):
+    def solve(self, seed, bulk):
+        """Assert random clauses (some repeating or complementing literals), one by one or all at once, then solve
+        under a few assumptions. Returns the results."""
+        monosat.Monosat().newSolver()
+        rnd = random.Random(seed)
+        vars = [monosat.Var() for _ in range(20)]
+        clauses = random_clauses(rnd, vars, rnd.randint(60, 100))
+        clauses += [c + c[:1] for c in random_clauses(rnd, vars, 5)]
+        clauses += [c + [monosat.Not(c[0])] for c in random_clauses(rnd, vars, 5)]
+        rnd.shuffle(clauses)
+        if bulk:
+            monosat.AssertClauses(clauses)
+        else:
+            for c in clauses:
+                monosat.AssertClause(c)
+        results = []
+        for _ in range(4):
+            result = monosat.Solve([v if rnd.random() < 0.5 else monosat.Not(v) for v in rnd.sample(vars, 3)])
+            if result:
+                self.assertTrue(all(any(l.value() for l in c) for c in clauses), seed)
+            results.append(result)
+        return results
+
+    def test_bulk_clauses(self):
+        for seed in range(40):
+            self.assertEqual(self.solve(seed, True), self.solve(seed, False), seed)
+
+    def test_buffers(self):
+        monosat.Monosat().newSolver()
+        a, b, c = monosat.Var(), monosat.Var(), monosat.Var()
+        lits = array.array("i", [a.getLit(), b.getLit(), monosat.Not(a).getLit(), c.getLit(), monosat.Not(c).getLit()])
+        offsets = array.array("i", [0, 2, 4, 5])
+        self.assertTrue(monosat.Monosat().addClauses(lits, offsets))
+        self.assertTrue(monosat.Monosat().addClauses([], []))
+        self.assertTrue(monosat.Solve())
+        self.assertEqual((b.value(), c.value()), (True, False))
+        # an empty clause makes the instance unsatisfiable
+        self.assertFalse(monosat.Monosat().addClauses(lits, [0, 0]))
+        self.assertFalse(monosat.Solve())
+        with self.assertRaises(RuntimeError):
+            monosat.Monosat().addClauses(lits, [0, 6])
+
+
+if __name__ == "__main__":
+    unittest.main()
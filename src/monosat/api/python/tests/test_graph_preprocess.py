@@ -0,0 +1,116 @@
+import random
+import unittest
+
+import monosat
+from tests.test_assumptions import build_instance, assumption_sequence, to_lits
+
+# Options are global to the library, so every solver in this file sets them explicitly.
+PREPROCESS = "-graph-dead-edges -graph-forced-edges"
+NO_PREPROCESS = "-no-graph-dead-edges -no-graph-forced-edges"
+
+
+def random_reach_graph(rnd, n_nodes, n_edges):
+    """A sparse random graph, with some reach constraints asserted. Returns the graph and its edges."""
+    g = monosat.Graph()
+    for _ in range(n_nodes):
+        g.addNode()
+    edges = [g.addEdge(*rnd.sample(range(n_nodes), 2)) for _ in range(n_edges)]
+    for _ in range(rnd.randint(1, 3)):
+        monosat.Assert(g.reaches(rnd.randrange(n_nodes), rnd.randrange(n_nodes)))
+    return g, edges
+
+
+def random_chain_graph(rnd, n_nodes):
+    """A random weighted graph whose nodes are joined by chains of edges through otherwise unconnected nodes,
+    with some reach and weighted distance atoms between the (chain end) nodes. Returns the graph, its edges, and the
+    atoms (as (atom, start, to) triples)."""
+    g = monosat.Graph()
+    for _ in range(n_nodes):
+        g.addNode()
+    edges = []
+    for _ in range(rnd.randint(n_nodes, 2 * n_nodes)):
+        path = rnd.sample(range(n_nodes), 2)
+        path[1:1] = [g.addNode() for _ in range(rnd.randint(0, 3))]
+        for (u, v) in zip(path, path[1:]):
+            edges.append(g.addEdge(u, v, rnd.randint(1, 5)))
+    atoms = []
+    for _ in range(rnd.randint(2, 5)):
+        start, to = rnd.sample(range(n_nodes), 2)
+        if rnd.random() < 0.5:
+            atoms.append((g.reaches(start, to), start, to))
+        else:
+            atoms.append((g.distance_leq(start, to, rnd.randint(4, 20)), start, to))
+    return g, edges, atoms
+
+
+class TestGraphPreprocess(unittest.TestCase):
+    def solve_incrementally(self, args, seed):
+        """Solve a random instance under a sequence of assumptions, adding new reach atoms between solves."""
+        monosat.Monosat().newSolver(args)
+        rnd = random.Random(seed)
+        g, edges = random_reach_graph(rnd, 12, rnd.randint(12, 24))
+        results = []
+        for i in range(6):
+            atom = g.reaches(rnd.randrange(12), rnd.randrange(12))
+            assumptions = [atom if rnd.random() < 0.7 else monosat.Not(atom)]
+            assumptions += [monosat.Not(e) for e in rnd.sample(edges, rnd.randint(0, 4))]
+            result = monosat.Solve(assumptions)
+            if result:
+                # the solution is checked by the graph theory; also check the assumed atom directly
+                self.assertEqual(assumptions[0].value(), True, (args, seed))
+            results.append(result)
+        return results
+
+    def test_new_atoms_between_solves(self):
+        for seed in range(40):
+            expect = self.solve_incrementally(NO_PREPROCESS, seed)
+            self.assertEqual(self.solve_incrementally(PREPROCESS, seed), expect, seed)
+
+    def solve_mixed(self, args, seed, sequence):
+        monosat.Monosat().newSolver(args)
+        atoms = build_instance(seed)
+        return [monosat.Solve(to_lits(atoms, assumptions)) for assumptions in sequence]
+
+    def test_graph_and_bv_constraints(self):
+        for seed in range(20):
+            sequence = assumption_sequence(seed + 200, 21, 8)
+            expect = self.solve_mixed(NO_PREPROCESS, seed, sequence)
+            self.assertEqual(self.solve_mixed(PREPROCESS, seed, sequence), expect, seed)
+
+    def check_path(self, g, edges, atom, start, to):
+        """Check that the model's path for a true atom is made of the graph's own (enabled) edges."""
+        nodes = g.getPath(atom)
+        self.assertEqual((nodes[0], nodes[-1]), (start, to))
+        path_edges = g.getPath(atom, True)
+        self.assertEqual(len(path_edges), len(nodes) - 1)
+        edge_lits = set(e.getLit() for e in edges)
+        for (u, v, e) in zip(nodes, nodes[1:], path_edges):
+            self.assertIn(e.getLit(), edge_lits)
+            self.assertTrue(e.value())
+            self.assertEqual(g.getEdgeFromVar(e)[:2], (u, v))
+
+    def solve_chains(self, args, seed):
+        """Solve a random chain graph under a sequence of assumptions, checking the paths of the true atoms."""
+        monosat.Monosat().newSolver(args)
+        rnd = random.Random(seed)
+        g, edges, atoms = random_chain_graph(rnd, 6)
+        results = []
+        for _ in range(6):
+            assumptions = [atom if rnd.random() < 0.6 else monosat.Not(atom) for (atom, _, _) in atoms]
+            assumptions += [monosat.Not(e) for e in rnd.sample(edges, rnd.randint(0, 3))]
+            result = monosat.Solve(assumptions)
+            if result:
+                for (atom, start, to) in atoms:
+                    if atom.value():
+                        self.check_path(g, edges, atom, start, to)
+            results.append(result)
+        return results
+
+    def test_chain_contraction(self):
+        for seed in range(40):
+            expect = self.solve_chains(NO_PREPROCESS + " -no-graph-contract-chains", seed)
+            self.assertEqual(self.solve_chains(PREPROCESS + " -graph-contract-chains", seed), expect, seed)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,38 @@
+import random
+import unittest
+
+import monosat
+
+
+class TestModel(unittest.TestCase):
+    def test_bulk_model_queries(self):
+        # the bulk queries must agree with querying each literal, bitvector or edge on its own
+        for seed in range(10):
+            rnd = random.Random(seed)
+            monosat.Monosat().newSolver()
+            vars = [monosat.Var() for _ in range(50)]
+            for _ in range(60):
+                monosat.AssertClause([v if rnd.random() < 0.5 else monosat.Not(v) for v in rnd.sample(vars, 3)])
+            bvs = [monosat.BitVector(6) for _ in range(6)]
+            for a, b in zip(bvs, bvs[1:]):
+                monosat.Assert(a + rnd.randint(0, 3) <= b)
+            g = monosat.Graph()
+            for _ in range(8):
+                g.addNode()
+            for _ in range(16):
+                g.addEdge(*rnd.sample(range(8), 2))
+            g.addUndirectedEdge(0, 7)
+            monosat.Assert(g.reaches(0, rnd.randrange(8)))
+            lits = vars + [monosat.Not(v) for v in vars[:10]] + [monosat.true(), monosat.false()]
+            if monosat.Solve():
+                self.assertEqual(monosat.getValues(lits), [v.value() for v in lits])
+                self.assertEqual(monosat.getBVValues(bvs), [bv.value() for bv in bvs])
+                self.assertEqual(monosat.getBVValues(bvs, True),
+                                 [monosat.Monosat().getModel_BV(bv.getID(), True) for bv in bvs])
+                self.assertEqual(g.getEdgeValues(), [e[2].value() for e in g.getAllEdges()])
+            self.assertEqual(monosat.getValues([]), [])
+            self.assertEqual(monosat.getBVValues([]), [])
+
+
+if __name__ == "__main__":
+    unittest.main()
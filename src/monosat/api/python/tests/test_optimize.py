@@ -0,0 +1,84 @@
+import itertools
+import random
+import unittest
+
+import monosat
+
+# Options are global to the library, so every solver in this file sets the optimization options explicitly.
+SEARCHES = [
+    "-search=0 -stratify",  # binary search
+    "-search=1 -stratify",  # linear search
+    "-search=3 -stratify",  # core-guided search
+    "-search=3 -no-stratify",
+]
+
+
+def evaluate(weights, assignment):
+    return sum(w for (v, w) in weights if assignment[v])
+
+
+def brute_force(n, clauses, weights, maximize):
+    best = None
+    for assignment in itertools.product([False, True], repeat=n):
+        if all(any(assignment[v] != neg for (v, neg) in c) for c in clauses):
+            value = evaluate(weights, assignment)
+            if best is None or (value > best if maximize else value < best):
+                best = value
+    return best
+
+
+class TestOptimize(unittest.TestCase):
+    def optimize(self, args, n, clauses, objectives):
+        monosat.Monosat().newSolver(args)
+        vars = [monosat.Var() for _ in range(n)]
+        for c in clauses:
+            monosat.AssertClause([monosat.Not(vars[v]) if neg else vars[v] for (v, neg) in c])
+        for (weights, maximize) in objectives:
+            lits = [vars[v].getLit() for (v, w) in weights]
+            ws = [w for (v, w) in weights]
+            if maximize:
+                monosat.Monosat().maximizeWeightedLits(lits, ws)
+            else:
+                monosat.Monosat().minimizeWeightedLits(lits, ws)
+        if not monosat.Solve():
+            return None
+        self.assertTrue(monosat.FoundOptimal())
+        assignment = [v.value() for v in vars]
+        for c in clauses:
+            self.assertTrue(any(assignment[v] != neg for (v, neg) in c))
+        return [evaluate(weights, assignment) for (weights, maximize) in objectives]
+
+    def random_instance(self, rnd):
+        n = rnd.randint(3, 10)
+        clauses = [[(v, rnd.random() < 0.5) for v in rnd.sample(range(n), rnd.randint(1, 3))]
+                   for _ in range(rnd.randint(0, 2 * n))]
+        return n, clauses
+
+    def random_objective(self, rnd, n):
+        return [(v, rnd.randint(1, 20)) for v in rnd.sample(range(n), rnd.randint(1, n))], rnd.random() < 0.5
+
+    def test_pb_objective(self):
+        rnd = random.Random(4321)
+        for _ in range(40):
+            n, clauses = self.random_instance(rnd)
+            weights, maximize = self.random_objective(rnd, n)
+            expect = brute_force(n, clauses, weights, maximize)
+            for args in SEARCHES:
+                result = self.optimize(args, n, clauses, [(weights, maximize)])
+                if expect is None:
+                    self.assertIsNone(result, args)
+                else:
+                    self.assertEqual(result, [expect], args)
+
+    def test_lexicographic_pb_objectives(self):
+        rnd = random.Random(8765)
+        for _ in range(25):
+            n, clauses = self.random_instance(rnd)
+            objectives = [self.random_objective(rnd, n) for _ in range(2)]
+            results = [self.optimize(args, n, clauses, objectives) for args in SEARCHES]
+            for args, result in zip(SEARCHES, results):
+                self.assertEqual(result, results[0], args)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,80 @@
+import random
+import unittest
+
+import monosat
+from tests.test_assumptions import build_instance, assumption_sequence, to_lits
+
+
+def random_cnf(rnd, atoms, n_vars, n_clauses):
+    """Random 3-CNF over fresh variables, some of which are tied to the theory atoms.
+    Returns the variables and clauses (as lists of (variable index, sign) pairs)."""
+    vars = [monosat.Var() for _ in range(n_vars)]
+    for atom in rnd.sample(atoms, min(len(atoms), n_vars // 4)):
+        monosat.AssertEq(vars[rnd.randrange(n_vars)], atom)
+    clauses = [[(v, rnd.random() < 0.5) for v in rnd.sample(range(n_vars), 3)] for _ in range(n_clauses)]
+    for c in clauses:
+        monosat.AssertClause([monosat.Not(vars[v]) if sign else vars[v] for (v, sign) in c])
+    return vars, clauses
+
+
+# Options are global to the library, so every solver in this file starts from these settings (later options override them)
+DEFAULTS = "-chrono=-1 -no-walk -rephase=0 "
+
+
+def satisfies(vars, clauses):
+    return all(any(vars[v].value() != sign for (v, sign) in c) for c in clauses)
+
+
+class TestSearch(unittest.TestCase):
+    def solve_random(self, args, seed, n_assumption_sets=6):
+        """Solve a random graph/bv/cnf instance under a sequence of assumptions, checking each model.
+        Returns the sequence of results."""
+        monosat.Monosat().newSolver(DEFAULTS + args)
+        atoms = build_instance(seed)
+        rnd = random.Random(seed)
+        vars, clauses = random_cnf(rnd, atoms, 40, rnd.randint(150, 180))
+        results = []
+        for assumptions in assumption_sequence(seed, 21, n_assumption_sets):
+            result = monosat.Solve(to_lits(atoms, assumptions))
+            if result:
+                self.assertTrue(satisfies(vars, clauses), (args, seed))
+            results.append(result)
+        return results
+
+    def test_chronological_backtracking(self):
+        # -chrono=0 backtracks chronologically after every conflict that would backjump more than one level
+        for seed in range(30):
+            expect = self.solve_random("-chrono=-1", seed)
+            self.assertEqual(self.solve_random("-chrono=0", seed), expect, seed)
+            self.assertEqual(self.solve_random("-chrono=2", seed), expect, seed)
+
+    def test_walk(self):
+        # local search only seeds the saved phases, so it must not change any results
+        for seed in range(30):
+            expect = self.solve_random("-no-walk", seed)
+            self.assertEqual(self.solve_random("-walk -walk-initial -rephase=50", seed), expect, seed)
+
+    def solve_with_units(self, args, seed):
+        """Solve a random instance with some unit clauses (assigned at level 0), checking that the model keeps them."""
+        monosat.Monosat().newSolver(DEFAULTS + args)
+        atoms = build_instance(seed)
+        rnd = random.Random(seed)
+        vars, clauses = random_cnf(rnd, atoms, 40, 150)
+        units = [(v, rnd.random() < 0.5) for v in rnd.sample(range(len(vars)), 8)]
+        for (v, sign) in units:
+            monosat.Assert(monosat.Not(vars[v]) if sign else vars[v])
+        result = monosat.Solve()
+        if result:
+            self.assertTrue(satisfies(vars, clauses), (args, seed))
+            for (v, sign) in units:
+                self.assertEqual(vars[v].value(), not sign, (args, seed))
+        return result
+
+    def test_walk_keeps_level_0_assignments(self):
+        for seed in range(30):
+            expect = self.solve_with_units("-no-walk", seed)
+            self.assertEqual(self.solve_with_units("-walk -walk-initial -rephase=50", seed), expect, seed)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -6348,6 +6348,30 @@ public:
         return false;
     }
 
+    bool supportsChronologicalBacktracking() override{
+        //out of order literals are appended to the trail at the current level, and re-enqueued by the solver if it
+        //backtracks past that level while keeping them
+        return true;
+    }
+
+    int explainLemma(const vec<Lit>& lemma, vec<int>& witness) override{
+        //the witness is the set of bitvectors whose bounds appear in the lemma
+        witness.clear();
+        for(Lit l:lemma){
+            if(isOperationVar(var(l))){
+                int bvID = unmapBV(getOperation(l).getBV());
+                bool seen = false;
+                for(int w:witness){
+                    seen |= w == bvID;
+                }
+                if(!seen){
+                    witness.push(bvID);
+                }
+            }
+        }
+        return -1;
+    }
+
 
     void newDecisionLevel() override{
         trail_lim.push(trail.size());
@@ -6397,6 +6421,10 @@ public:
     }
 
 
+    bool hasPendingConstraints() override{
+        return const_true == lit_Undef;
+    }
+
     void preprocess() override{
         if(const_true == lit_Undef)
             const_true = True();
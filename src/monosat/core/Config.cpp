@@ -104,6 +104,10 @@ StringOption Monosat::opt_debug_learnt_clauses(_cat, "debug-learnts",
                                                "");
 FILE* Monosat::opt_write_learnt_clauses = nullptr;
 
+BoolOption Monosat::opt_buffer_api_log(_cat, "buffer-log",
+                                       "Buffer the log of API calls (see setOutputFile) in memory, and write it to disk from a background thread, instead of flushing it after every call (logs ending in .gz are always buffered)",
+                                       true);
+
 //StringOption Monosat::StringOption opt_fsm_model(_cat_fsm,"File to write fsm model, if fsm theory is used","","");
 
 BoolOption Monosat::opt_write_bv_analysis(_cat, "debug-analysis", "", false);
@@ -155,8 +159,11 @@ BoolOption  Monosat::opt_strict_search_optimization(_cat_opt, "strict-search",
                                                     "Use strict (rather than >=/<=) constraints during optimization (be warned, this is not always safe!)",
                                                     false);
 IntOption  Monosat::opt_optimization_search_type(_cat_opt, "search",
-                                                 "0: Use binary search for optimization. 1: Use linear search. 2: Use binary search, but switch to linear search for hard values.",
-                                                 0, IntRange(0, 2));
+                                                 "0: Use binary search for optimization. 1: Use linear search. 2: Use binary search, but switch to linear search for hard values. 3: Use core-guided (OLL) search for pb objectives (bv objectives use binary search).",
+                                                 0, IntRange(0, 3));
+BoolOption Monosat::opt_optimization_stratify(_cat_opt, "stratify",
+                                              "During core-guided optimization, assume soft literals in decreasing order of weight",
+                                              true);
 DoubleOption Monosat::opt_rnd_optimization_freq(_cat_graph, "search-freq", "", 0.5, DoubleRange(0, true, 1, true));
 DoubleOption Monosat::opt_rnd_optimization_restart_freq(_cat_graph, "search-restart-freq", "", 0.05,
                                                         DoubleRange(0, true, 1, true));
@@ -169,6 +176,10 @@ BoolOption Monosat::opt_amo_eager_prop(_cat_amo, "amo-eager-prop",
                                        "Propagate a-m-o literals as soon as they are implied, instead of waiting for theory propagation",
                                        true);
 
+IntOption Monosat::opt_amo_merge_limit(_cat_amo, "amo-merge-limit",
+                                       "Merge overlapping at-most-one predicates into larger cliques at level 0, examining at most this many candidate literals per predicate. 0 to disable merging.",
+                                       1000, IntRange(0, INT32_MAX));
+
 BoolOption Monosat::opt_interpolate(_cat_sms, "interpolate",
                                     "Store learnt interface clauses to form interpolants between modules", false);
 IntOption Monosat::opt_eager_prop(_cat_sms, "eager-prop",
@@ -249,6 +260,9 @@ BoolOption Monosat::opt_keep_lazy_conflicts(_cat_theory, "keep-lazy-conflicts",
                                             "Keep clauses from lazy conflicts (only relevant if lazy-backtracking is enabled)",
                                             true);
 BoolOption Monosat::opt_lazy_backtrack_redecide(_cat_theory, "lazy-backtrack-redecide", "", false);
+BoolOption Monosat::opt_skip_theory_backtrack(_cat_theory, "skip-theory-backtrack",
+                                              "When backtracking, skip theory solvers that have not been given (or propagated) any literals above the backtrack level",
+                                              true);
 BoolOption Monosat::opt_vsids_both(_cat_theory, "vsids-both",
                                    "Use vsids decision heuristic for both theories and main solver, in combination",
                                    false);
@@ -487,6 +501,49 @@ BoolOption Monosat::opt_propagate_theories_during_fast_simplification(_cat, "the
                                                                       true);
 
 
+BoolOption Monosat::opt_stable_mode(_cat, "stable",
+                                    "Alternate between focused search (using the regular restart sequence) and stable search, which restarts rarely and decides variables in their target phase",
+                                    false);
+IntOption Monosat::opt_stable_first(_cat, "stable-first", "Conflicts before the first switch from focused to stable search",
+                                    1000, IntRange(1, INT32_MAX));
+DoubleOption Monosat::opt_stable_inc(_cat, "stable-inc",
+                                     "Factor by which each successive focused (or stable) search phase is longer than the last",
+                                     2, DoubleRange(1, true, HUGE_VAL, false));
+IntOption Monosat::opt_stable_restart_first(_cat, "stable-rfirst",
+                                            "The base restart interval in stable search (which always uses the Luby sequence)",
+                                            1024, IntRange(1, INT32_MAX));
+BoolOption Monosat::opt_target_phases(_cat, "target-phases",
+                                      "In stable search, decide variables in the polarity they had in the largest conflict-free assignment since the last restart",
+                                      true);
+BoolOption Monosat::opt_target_theory_decisions(_cat, "target-theory-decisions",
+                                                "In stable search, also make theory decisions in the target phase of the decided variable",
+                                                false);
+IntOption Monosat::opt_rephase(_cat, "rephase",
+                               "Conflicts between resets of the saved phases to the original, inverted, or best assignment (the interval grows arithmetically; 0 to disable)",
+                               0, IntRange(0, INT32_MAX));
+BoolOption Monosat::opt_walk(_cat, "walk",
+                             "Seed the saved phases by local search over the problem clauses (theory atoms unconstrained) at some rephases (see -rephase)",
+                             false);
+BoolOption Monosat::opt_walk_initial(_cat, "walk-initial",
+                                     "Also seed the saved phases by local search before the first solve (requires -walk)", true);
+DoubleOption Monosat::opt_walk_effort(_cat, "walk-effort",
+                                      "Maximum number of local search flips per walk, as a multiple of the number of problem clauses",
+                                      10, DoubleRange(0, true, HUGE_VAL, false));
+DoubleOption Monosat::opt_walk_time(_cat, "walk-time", "Maximum CPU time (in seconds) to spend in each local search walk",
+                                    1, DoubleRange(0, true, HUGE_VAL, false));
+StringOption Monosat::opt_proof(_cat, "proof",
+                                "Write a proof of unsatisfiability (DRAT, extended with trusted theory lemmas; see core/Proof.h) to this file (empty string disables)",
+                                "");
+BoolOption Monosat::opt_proof_binary(_cat, "proof-binary", "Write the proof in binary (rather than text) format", true);
+
+IntOption Monosat::opt_chrono(_cat, "chrono",
+                               "Backtrack chronologically (by a single level) after a conflict whose learnt clause would backjump more than this many levels (-1 to always backjump)",
+                               100, IntRange(-1, INT32_MAX));
+
+BoolOption Monosat::opt_reuse_assumptions(_cat, "reuse-assumptions",
+                                         "At the start of each solve, only backtrack as far as the first assumption that differs from the previous solve (rather than to level 0), so that an unchanged prefix of assumptions is not re-propagated",
+                                         true);
+
 BoolOption Monosat::opt_theory_propagate_assumptions(_cat, "theory-prop-during-assumps",
                                                      "Apply theory propagation while assigning assumptions (can be slow, if there are many assumptions)",
                                                      false);
@@ -516,6 +573,34 @@ IntOption  Monosat::opt_graph_prop_skip(_cat_graph, "graph-theory-skip",
                                         "Only process every nth graph theory propagation ('1' skips no propagations)",
                                         1, IntRange(1, INT32_MAX));
 
+IntOption  Monosat::opt_graph_prop_threads(_cat_graph, "graph-threads",
+                                           "Number of threads used to update graph detectors in parallel before propagating them ('1' disables parallel updates). Only reach and distance detectors are updated in parallel; maxflow, minimum spanning tree, connected component, cycle and Steiner tree detectors are always updated sequentially. Literals are still assigned in detector order, so the search is the same for any number of threads >1.",
+                                           1, IntRange(1, 256));
+
+BoolOption Monosat::opt_graph_dead_edges(_cat_graph, "graph-dead-edges",
+                                         "Before search, leave edges that are not on any path from the source of a reach or distance constraint to one of its nodes (in the level 0 over-approximate graph) out of the graphs used by the graph theory. Only applies to graphs with no other kinds of constraints; the literals of these edges remain free. Not used with -lazy-backtrack.",
+                                         false);
+
+BoolOption Monosat::opt_graph_forced_edges(_cat_graph, "graph-forced-edges",
+                                           "Before search, learn that edges on every path from the source of a reach or distance constraint to its node (in the level 0 over-approximate graph) must be enabled if that constraint holds. Once any such clause is learnt, no more edges or nodes can be added to that graph. Not used with -lazy-backtrack.",
+                                           false);
+
+BoolOption Monosat::opt_graph_contract_chains(_cat_graph, "graph-contract-chains",
+                                              "Before search, replace each chain of edges whose inner nodes have exactly one incoming and one outgoing edge (and are not the source or node of any constraint) by a single new edge, which is enabled exactly when all of the chain's edges are, and has their total weight. Only applies to graphs with only reach and weighted distance constraints, and constant edge weights. Once any chain is contracted, no more edges or nodes can be added to that graph. Not used with -lazy-backtrack.",
+                                              false);
+
+BoolOption Monosat::opt_graph_detector_order(_cat_graph, "graph-detector-order",
+                                            "Propagate graph detectors in order of their (decaying) conflict and propagation activity, rather than in the order they were created",
+                                            false);
+
+BoolOption Monosat::opt_graph_skip_unchanged(_cat_graph, "graph-skip-unchanged",
+                                            "Skip propagating graph detectors whose graphs and atoms have not changed since they were last propagated without conflict",
+                                            true);
+
+DoubleOption Monosat::opt_graph_detector_decay(_cat_graph, "graph-detector-decay",
+                                               "Decay factor for the activity of graph detectors (see -graph-detector-order)",
+                                               0.95, DoubleRange(0, false, 1, true));
+
 IntOption  Monosat::opt_bv_prop_skip(_cat_bv, "bv-theory-skip",
                                      "Only process every nth bv theory propagation ('1' skips no propagations)", 1,
                                      IntRange(1, INT32_MAX));
@@ -533,8 +618,11 @@ BoolOption Monosat::opt_fsm_negate_underapprox(_cat_fsm, "fsm-negate-under",
                                                "", false);//this option appears to be broken
 BoolOption Monosat::opt_fsm_forced_edge_prop(_cat_fsm, "fsm-forced-edge-prop","", false);
 BoolOption Monosat::opt_fsm_edge_prop(_cat_fsm, "fsm-edge-prop", "", false);
-BoolOption Monosat::opt_fsm_as_graph(_cat_fsm, "fsm-as-graph","", true);
+BoolOption Monosat::opt_fsm_as_graph(_cat_fsm, "fsm-as-graph","Check fsm acceptance constraints using reachability in a graph encoding of the fsm, instead of by simulating the fsm directly", true);
 BoolOption Monosat::opt_fsm_chokepoint_prop(_cat_fsm, "fsm-chokepoint","", false);
+BoolOption Monosat::opt_fsm_bitparallel(_cat_fsm, "fsm-bitparallel",
+                                        "Simulate fsm state sets using word-packed bitsets. Only applies with -no-fsm-as-graph: acceptance constraints use the simulation directly, while generation constraints only use it to reject strings that cannot be generated before searching for a generating path. Acceptance constraints also share the simulation of common string prefixes, through a trie of their strings",
+                                        true);
 
 BoolOption Monosat::opt_learn_acyclic_flows(_cat_graph, "learn-acyclic-flows","", false);
 
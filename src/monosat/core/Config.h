@@ -72,11 +72,14 @@ extern BoolOption opt_parser_immediate_mode;
 extern BoolOption opt_remap_vars;
 extern BoolOption opt_decide_optimization_lits;
 extern IntOption opt_optimization_search_type;
+extern BoolOption opt_optimization_stratify;
 
 extern IntOption opt_clausify_amo;
 extern BoolOption opt_amo_eager_prop;
+extern IntOption opt_amo_merge_limit;
 
 extern StringOption opt_debug_learnt_clauses;
+extern BoolOption opt_buffer_api_log;
 extern BoolOption opt_debug_model;
 extern int64_t opt_n_learnts;
 extern BoolOption opt_write_bv_bounds;
@@ -109,6 +112,7 @@ extern BoolOption opt_lazy_backtrack_decisions;
 extern IntOption opt_lazy_conflicts;
 extern BoolOption opt_keep_lazy_conflicts;
 extern BoolOption opt_lazy_backtrack_redecide;
+extern BoolOption opt_skip_theory_backtrack;
 extern BoolOption opt_theory_order_vsids;
 extern BoolOption opt_theory_order_swapping;
 extern BoolOption opt_theory_order_swapping_first_on_unit;
@@ -138,6 +142,21 @@ extern BoolOption opt_theory_internal_vsids;
 extern BoolOption opt_theory_prioritize_conflicts;
 extern BoolOption opt_theory_priority_clear;
 extern BoolOption opt_theory_propagate_assumptions;
+extern BoolOption opt_reuse_assumptions;
+extern IntOption opt_chrono;
+extern BoolOption opt_stable_mode;
+extern IntOption opt_stable_first;
+extern DoubleOption opt_stable_inc;
+extern IntOption opt_stable_restart_first;
+extern BoolOption opt_target_phases;
+extern BoolOption opt_target_theory_decisions;
+extern IntOption opt_rephase;
+extern BoolOption opt_walk;
+extern BoolOption opt_walk_initial;
+extern DoubleOption opt_walk_effort;
+extern DoubleOption opt_walk_time;
+extern StringOption opt_proof;
+extern BoolOption opt_proof_binary;
 
 extern BoolOption opt_check_solution;
 extern BoolOption opt_print_reach;
@@ -232,6 +251,13 @@ extern BoolOption opt_shortest_path_prune_dist;
 extern BoolOption opt_graph_bv_prop;
 
 extern IntOption opt_graph_prop_skip;
+extern IntOption opt_graph_prop_threads;
+extern BoolOption opt_graph_dead_edges;
+extern BoolOption opt_graph_forced_edges;
+extern BoolOption opt_graph_contract_chains;
+extern BoolOption opt_graph_detector_order;
+extern BoolOption opt_graph_skip_unchanged;
+extern DoubleOption opt_graph_detector_decay;
 extern IntOption opt_bv_prop_skip;
 extern IntOption opt_fsm_prop_skip;
 
@@ -243,6 +269,7 @@ extern BoolOption opt_fsm_chokepoint_prop;
 extern BoolOption opt_fsm_as_graph;
 extern IntOption opt_fsm_symmetry_breaking;
 extern BoolOption opt_fsm_track_used_transitions;
+extern BoolOption opt_fsm_bitparallel;
 
 extern BoolOption opt_learn_acyclic_flows;
 
@@ -0,0 +1,191 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2026, The MonoSAT Contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/core/LocalSearch.h"
+#include "monosat/mtl/Rnd.h"
+#include "monosat/utils/System.h"
+#include <cmath>
+
+using namespace Monosat;
+
+void LocalSearch::clear(int n_vars){
+    lits.clear();
+    clause_start.clear();
+    clause_start.push(0);
+    for(int i = 0; i < occurs.size(); i++){
+        occurs[i].clear();
+    }
+    occurs.growTo(2 * n_vars);
+    assignment.growTo(n_vars, 0);
+    best.growTo(n_vars, 0);
+    is_changed.growTo(n_vars, 0);
+}
+
+void LocalSearch::addClause(const vec<Lit>& clause){
+    assert(clause.size() > 0);
+    int c = nClauses();
+    for(Lit l:clause){
+        assert(var(l) < assignment.size());
+        lits.push(l);
+        occurs[toInt(l)].push(c);
+    }
+    clause_start.push(lits.size());
+}
+
+int LocalSearch::breakCount(Lit l) const{
+    //the number of clauses that would become unsatisfied if (the currently false literal) l was made true
+    int n = 0;
+    for(int c:occurs[toInt(~l)]){
+        if(n_true[c] == 1){
+            n++;
+        }
+    }
+    return n;
+}
+
+void LocalSearch::setUnsat(int c){
+    assert(unsat_pos[c] < 0);
+    unsat_pos[c] = unsat.size();
+    unsat.push(c);
+}
+
+void LocalSearch::setSat(int c){
+    assert(unsat_pos[c] >= 0);
+    int pos = unsat_pos[c];
+    int last = unsat.last();
+    unsat[pos] = last;
+    unsat_pos[last] = pos;
+    unsat.pop();
+    unsat_pos[c] = -1;
+}
+
+void LocalSearch::flip(Var v){
+    Lit was_true = mkLit(v, !assignment[v]);
+    assignment[v] = !assignment[v];
+    for(int c:occurs[toInt(was_true)]){
+        if(--n_true[c] == 0){
+            setUnsat(c);
+        }
+    }
+    for(int c:occurs[toInt(~was_true)]){
+        if(n_true[c]++ == 0){
+            setSat(c);
+        }
+    }
+    if(!is_changed[v]){
+        is_changed[v] = true;
+        changed.push(v);
+    }
+}
+
+int LocalSearch::walk(vec<char>& polarity, int64_t max_flips, double max_time){
+    int n_clauses = nClauses();
+    for(Var v = 0; v < assignment.size(); v++){
+        assignment[v] = !polarity[v];
+        best[v] = assignment[v];
+    }
+    n_true.clear();
+    n_true.growTo(n_clauses, 0);
+    unsat_pos.clear();
+    unsat_pos.growTo(n_clauses, -1);
+    unsat.clear();
+    for(int c = 0; c < n_clauses; c++){
+        for(int i = clause_start[c]; i < clause_start[c + 1]; i++){
+            if(isTrue(lits[i])){
+                n_true[c]++;
+            }
+        }
+        if(n_true[c] == 0){
+            setUnsat(c);
+        }
+    }
+    if(unsat.size() == 0){
+        return 0;
+    }
+
+    //The break weight of a literal is cb^-break, with cb chosen by the average clause length,
+    //interpolating the values found by Balint & Schoening for uniform random k-SAT.
+    static const double cbs[][2] = {{0, 2.0}, {3, 2.5}, {4, 2.85}, {5, 3.7}, {6, 5.1}, {7, 7.4}};
+    static const int n_cbs = sizeof(cbs) / sizeof(cbs[0]);
+    double avg_len = n_clauses > 0 ? ((double) lits.size()) / n_clauses : 0;
+    double cb = cbs[n_cbs - 1][1];
+    for(int i = 1; i < n_cbs; i++){
+        if(avg_len <= cbs[i][0]){
+            double frac = (avg_len - cbs[i - 1][0]) / (cbs[i][0] - cbs[i - 1][0]);
+            cb = cbs[i - 1][1] + frac * (cbs[i][1] - cbs[i - 1][1]);
+            break;
+        }
+    }
+    break_prob.clear();
+    for(double p = 1; p > 1e-300; p /= cb){
+        break_prob.push(p);
+    }
+
+    int best_unsat = unsat.size();
+    for(Var v:changed){
+        is_changed[v] = false;
+    }
+    changed.clear();
+    double start_time = cpuTime();
+    int64_t flips = 0;
+    while(unsat.size() > 0 && flips < max_flips){
+        if((flips & 1023) == 1023 && cpuTime() - start_time > max_time){
+            break;
+        }
+        int c = unsat[irand(random_seed, unsat.size())];
+        probs.clear();
+        double sum = 0;
+        for(int i = clause_start[c]; i < clause_start[c + 1]; i++){
+            int b = breakCount(lits[i]);
+            double p = b < break_prob.size() ? break_prob[b] : break_prob.last();
+            probs.push(p);
+            sum += p;
+        }
+        double r = drand(random_seed) * sum;
+        int pick = clause_start[c + 1] - 1;
+        for(int i = 0; i < probs.size(); i++){
+            r -= probs[i];
+            if(r <= 0){
+                pick = clause_start[c] + i;
+                break;
+            }
+        }
+        flip(var(lits[pick]));
+        flips++;
+        if(unsat.size() < best_unsat){
+            best_unsat = unsat.size();
+            for(Var v:changed){
+                best[v] = assignment[v];
+                is_changed[v] = false;
+            }
+            changed.clear();
+        }
+    }
+    stats_flips += flips;
+    for(Var v:changed){
+        is_changed[v] = false;
+    }
+    changed.clear();
+    for(Var v = 0; v < best.size(); v++){
+        polarity[v] = !best[v];
+    }
+    return best_unsat;
+}
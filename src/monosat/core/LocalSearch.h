@@ -0,0 +1,88 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2026, The MonoSAT Contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef MONOSAT_LOCALSEARCH_H
+#define MONOSAT_LOCALSEARCH_H
+
+#include "monosat/core/SolverTypes.h"
+#include "monosat/mtl/Vec.h"
+#include <cstdint>
+
+namespace Monosat {
+
+/**
+ * A ProbSAT-style stochastic local search (Balint & Schoening, 2012) over a set of clauses.
+ * The solver uses this to search for a (near-)satisfying assignment of its Boolean skeleton - its problem clauses,
+ * with theory atoms treated as unconstrained variables - and then uses the best assignment found as its saved phases.
+ *
+ * Usage: clear(), then addClause() for each clause (with literals that are false at level 0 already removed,
+ * and clauses satisfied at level 0 left out), then walk().
+ */
+class LocalSearch {
+    vec<Lit> lits;//all clause literals, stored contiguously
+    vec<int> clause_start;//clause i consists of lits[clause_start[i]] .. lits[clause_start[i+1]-1]
+    vec<vec<int>> occurs;//clauses in which each literal occurs
+    vec<int> n_true;//number of true literals in each clause
+    vec<int> unsat;//the currently unsatisfied clauses
+    vec<int> unsat_pos;//position of each clause in 'unsat', or -1
+    vec<char> assignment;//current truth value of each variable
+    vec<char> best;//the assignment with the fewest unsatisfied clauses found so far
+    vec<Var> changed;//variables flipped since 'best' was last updated
+    vec<char> is_changed;
+    vec<double> probs;//scratch space for the break probabilities of a clause's literals
+    vec<double> break_prob;//probability weight for each break value
+    double random_seed;
+
+    bool isTrue(Lit l) const{
+        return assignment[var(l)] != sign(l);
+    }
+
+    int breakCount(Lit l) const;
+
+    void flip(Var v);
+
+    void setUnsat(int c);
+
+    void setSat(int c);
+
+public:
+    int64_t stats_flips = 0;
+
+    explicit LocalSearch(double seed = 91648253) : random_seed(seed){
+    }
+
+    int nClauses() const{
+        return clause_start.size() > 0 ? clause_start.size() - 1 : 0;
+    }
+
+    void clear(int n_vars);
+
+    void addClause(const vec<Lit>& clause);
+
+    //Walk from the assignment given by 'polarity' (in the solver's convention: polarity[v] is true if v should be
+    //assigned false), until all clauses are satisfied, 'max_flips' flips have been made, or 'max_time' seconds have
+    //passed. On return, 'polarity' holds the assignment with the fewest unsatisfied clauses that was found, and
+    //that number of clauses is returned.
+    int walk(vec<char>& polarity, int64_t max_flips, double max_time);
+};
+}
+
+#endif //MONOSAT_LOCALSEARCH_H
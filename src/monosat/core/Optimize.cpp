@@ -782,6 +782,308 @@ int optimize_binary_pb(Monosat::SimpSolver* S, PB::PBConstraintSolver* pbSolver,
 }
 
 
+//Incremental totalizer, used by the core-guided search to count how many literals of a core are true.
+//outputs[k] is implied true whenever at least k+1 of the inputs are true; outputs are only created up to the
+//bound that has been requested so far, and extended on demand.
+struct Totalizer {
+    struct Node {
+        int left = -1;
+        int right = -1;
+        int size = 0;
+        vec<Lit> outputs;
+    };
+    vec<Node> nodes;
+    int root = -1;
+
+    void init(const vec<Lit>& inputs){
+        assert(inputs.size() > 0);
+        nodes.clear();
+        root = build(inputs, 0, inputs.size());
+    }
+
+    int size() const{
+        return nodes[root].size;
+    }
+
+    //Returns a literal that is implied true whenever at least k of the inputs are true (k>0).
+    Lit atLeast(SimpSolver* S, int k){
+        assert(k > 0);
+        assert(k <= size());
+        extend(S, root, k);
+        return nodes[root].outputs[k - 1];
+    }
+
+private:
+    int build(const vec<Lit>& inputs, int from, int to){
+        int n = nodes.size();
+        nodes.push();
+        nodes[n].size = to - from;
+        if(to - from == 1){
+            nodes[n].outputs.push(inputs[from]);
+        }else{
+            int mid = from + (to - from) / 2;
+            int left = build(inputs, from, mid);
+            int right = build(inputs, mid, to);
+            nodes[n].left = left;
+            nodes[n].right = right;
+        }
+        return n;
+    }
+
+    void extend(SimpSolver* S, int n, int k){
+        k = std::min(k, nodes[n].size);
+        if(nodes[n].outputs.size() >= k)
+            return;
+        int left = nodes[n].left;
+        int right = nodes[n].right;
+        assert(left >= 0 && right >= 0);
+        extend(S, left, k);
+        extend(S, right, k);
+        int old_k = nodes[n].outputs.size();
+        while(nodes[n].outputs.size() < k){
+            nodes[n].outputs.push(mkLit(S->newVar(true, opt_decide_optimization_lits)));
+        }
+        const vec<Lit>& a = nodes[left].outputs;
+        const vec<Lit>& b = nodes[right].outputs;
+        const vec<Lit>& r = nodes[n].outputs;
+        //only the clauses implying the new outputs (old_k,k] are added; the clauses for the existing outputs are unchanged
+        for(int i = 0; i <= a.size(); i++){
+            for(int j = 0; j <= b.size(); j++){
+                int sum = i + j;
+                if(sum <= old_k || sum > k)
+                    continue;
+                if(i == 0){
+                    S->addClause(~b[j - 1], r[sum - 1]);
+                }else if(j == 0){
+                    S->addClause(~a[i - 1], r[sum - 1]);
+                }else{
+                    S->addClause(~a[i - 1], ~b[j - 1], r[sum - 1]);
+                }
+            }
+        }
+    }
+};
+
+//Core-guided (OLL) minimization of a pseudo-Boolean objective.
+//Each objective literal is assumed to take its cheaper value; each unsat core of those assumptions raises the lower
+//bound by the smallest weight in the core, and is relaxed by a totalizer over the core, whose 'at least k' outputs
+//become new soft assumptions. If stratification is enabled, only soft literals with weights above a decreasing
+//threshold are assumed, so that early models are found quickly and give good upper bounds.
+int optimize_core_pb(Monosat::SimpSolver* S, bool invert, const vec<Lit>& assumes, const Objective& o,
+                     bool& hit_cutoff, int64_t& n_solves, bool& found_model){
+    hit_cutoff = false;
+
+    //the objective is rewritten as 'base + sign*cost', where cost is the sum of the weights of the true cost literals.
+    struct Soft {
+        Lit cost_lit;//the soft assumption is ~cost_lit
+        int64_t weight;
+        int totalizer = -1;//if this soft literal is a totalizer output, its totalizer, and bound
+        int bound = 0;
+        int64_t sum_weight = 0;//the weight that the next output of the totalizer will receive
+    };
+    vec<Soft> softs;
+    vec<int> soft_of_var;
+    vec<Totalizer> totalizers;
+    int64_t base = 0;
+    int64_t sign = invert ? -1 : 1;
+
+    for(int i = 0; i < o.pb_lits.size(); i++){
+        Lit l = o.pb_lits[i];
+        if(l == lit_Undef)
+            continue;
+        int64_t weight = i < o.pb_weights.size() ? o.pb_weights[i] : 1;
+        if(weight == 0)
+            continue;
+        if(invert){
+            base += std::max(weight, (int64_t) 0);
+        }else{
+            base += std::min(weight, (int64_t) 0);
+        }
+        //the cost literal is the one whose truth moves the objective in the wrong direction
+        Lit cost_lit = ((weight > 0) != invert) ? l : ~l;
+        soft_of_var.growTo(S->nVars(), -1);
+        int s = soft_of_var[var(l)];
+        if(s >= 0){
+            if(softs[s].cost_lit == cost_lit){
+                softs[s].weight += std::abs(weight);
+            }else{
+                //l and ~l both appear, one of the two weights is always paid
+                int64_t w = std::min(softs[s].weight, std::abs(weight));
+                if(softs[s].weight < std::abs(weight)){
+                    softs[s].cost_lit = cost_lit;
+                }
+                softs[s].weight = std::abs(softs[s].weight - std::abs(weight));
+                //fold the unavoidable cost into the base
+                base += sign * w;
+            }
+        }else{
+            soft_of_var[var(l)] = softs.size();
+            softs.push();
+            softs.last().cost_lit = cost_lit;
+            softs.last().weight = std::abs(weight);
+        }
+    }
+
+    int64_t lower_bound = 0;//on the cost
+    int n_cores = 0;
+    bool have_value = found_model;
+    int value = evalPB(*S, o, !invert, !found_model);
+
+    //objective value corresponding to the given cost lower bound
+    auto bound_value = [&](int64_t cost) -> int64_t{
+        return base + sign * cost;
+    };
+
+    auto print_progress = [&](){
+        if(have_value){
+            printf("\rCore-guided pb: bound %" PRId64 ", best %d (%d cores)", bound_value(lower_bound), value,
+                   n_cores);
+        }else{
+            printf("\rCore-guided pb: bound %" PRId64 " (%d cores)", bound_value(lower_bound), n_cores);
+        }
+        fflush(stdout);
+    };
+
+    //stratification: only soft literals with weight >= threshold are assumed
+    int64_t threshold = 1;
+    if(opt_optimization_stratify){
+        for(Soft& s:softs){
+            threshold = std::max(threshold, s.weight);
+        }
+    }
+
+    vec<Lit> assume;
+    vec<int> core;
+    while(!hit_cutoff){
+        if(have_value && !lt(bound_value(lower_bound), value, invert)){
+            //the best model meets the lower bound
+            break;
+        }
+        assume.clear();
+        for(Lit l:assumes)
+            assume.push(l);
+        for(Soft& s:softs){
+            if(s.weight > 0 && s.weight >= threshold){
+                assume.push(~s.cost_lit);
+            }
+        }
+
+        n_solves++;
+        int64_t conflict_limit = S->getConflictBudget();
+        if(conflict_limit < 0)
+            conflict_limit = INT32_MAX;
+        int64_t opt_lim = opt_limit_optimization_conflicts;
+        if(opt_lim <= 0)
+            opt_lim = INT32_MAX;
+        int64_t limit = std::min(opt_lim, conflict_limit);
+        if(limit >= INT32_MAX){
+            limit = -1;//disable limit.
+        }
+        S->setConfBudget(limit);
+        lbool res = S->solveLimited(assume, false, false);
+        found_model |= (res == l_True);
+        if(res == l_Undef){
+            hit_cutoff = true;
+            if(opt_verb > 0){
+                printf("\nBudget exceeded during optimization, quiting early (model might not be optimal!)\n");
+            }
+            break;
+        }else if(res == l_True){
+            for(Lit l:assumes){
+                if(S->value(l) != l_True){
+                    throw std::runtime_error("Error in optimization (model is inconsistent with assumptions)");
+                }
+            }
+            int model_value = evalPB(*S, o, !invert);
+            if(!have_value || lt(model_value, value, invert)){
+                value = model_value;
+                have_value = true;
+            }
+            //lower the threshold to the next stratum
+            int64_t next = 0;
+            for(Soft& s:softs){
+                if(s.weight > 0 && s.weight < threshold)
+                    next = std::max(next, s.weight);
+            }
+            if(next == 0){
+                //all soft literals are satisfied, so this model is optimal
+                break;
+            }
+            threshold = next;
+        }else{
+            //collect the soft literals in the core, by looking up each conflict literal's soft literal
+            //(the conflict contains the negations of the failed assumptions, which are the cost literals)
+            core.clear();
+            for(Lit p:S->conflict.toVec()){
+                if(var(p) >= soft_of_var.size())
+                    continue;
+                int s = soft_of_var[var(p)];
+                if(s >= 0 && softs[s].cost_lit == p && softs[s].weight > 0 && softs[s].weight >= threshold){
+                    core.push(s);
+                }
+            }
+            if(core.size() == 0){
+                //the hard constraints are unsatisfiable under the assumptions
+                break;
+            }
+            n_cores++;
+            int64_t min_weight = INT64_MAX;
+            for(int s:core){
+                min_weight = std::min(min_weight, softs[s].weight);
+            }
+            lower_bound += min_weight;
+            S->cancelUntil(0);
+            vec<Lit> core_lits;
+            for(int s:core){
+                softs[s].weight -= min_weight;
+                core_lits.push(softs[s].cost_lit);
+            }
+            //if a totalizer output was in the core, its next output becomes soft
+            for(int s:core){
+                if(softs[s].totalizer >= 0 && softs[s].bound < totalizers[softs[s].totalizer].size()){
+                    int t = softs[s].totalizer;
+                    int bound = softs[s].bound + 1;
+                    int64_t w = softs[s].sum_weight;
+                    Lit out = totalizers[t].atLeast(S, bound);
+                    soft_of_var.growTo(S->nVars(), -1);
+                    soft_of_var[var(out)] = softs.size();
+                    softs.push();
+                    softs.last().cost_lit = out;
+                    softs.last().weight = w;
+                    softs.last().totalizer = t;
+                    softs.last().bound = bound;
+                    softs.last().sum_weight = w;
+                    softs[s].totalizer = -1;
+                }
+            }
+            if(core_lits.size() > 1){
+                //at least one of the core literals is true; penalize each additional true literal
+                totalizers.push();
+                totalizers.last().init(core_lits);
+                int t = totalizers.size() - 1;
+                Lit out = totalizers[t].atLeast(S, 2);
+                soft_of_var.growTo(S->nVars(), -1);
+                soft_of_var[var(out)] = softs.size();
+                softs.push();
+                softs.last().cost_lit = out;
+                softs.last().weight = min_weight;
+                softs.last().totalizer = t;
+                softs.last().bound = 2;
+                softs.last().sum_weight = min_weight;
+            }
+        }
+        if(opt_verb >= 1 || opt_verb_optimize >= 1){
+            print_progress();
+        }
+    }
+    if(opt_verb >= 1 || opt_verb_optimize >= 1){
+        print_progress();
+        printf("\n");
+    }
+    S->cancelUntil(0);
+    return value;
+}
+
 int64_t optimize_binary_bv(Monosat::SimpSolver* S, Monosat::BVTheorySolver<int64_t>* bvTheory, bool maximize,
                            const vec<Lit>& assumes, int bvID, bool& hit_cutoff, int64_t& n_solves, bool& found_model){
 
@@ -1486,6 +1788,10 @@ lbool optimize_and_solve(SimpSolver& S, const vec<Lit>& assumes, const vec<Objec
                     }else if(opt_optimization_search_type == 2){
                         val = optimize_binary_restart_bv(&S, bvTheory, objectives[i].maximize, assume, bvID, hit_cutoff,
                                                          n_solves, ever_solved);
+                    }else if(opt_optimization_search_type == 3){
+                        //core-guided search only applies to pb objectives
+                        val = optimize_binary_bv(&S, bvTheory, objectives[i].maximize, assume, bvID, hit_cutoff,
+                                                 n_solves, ever_solved);
                     }else{
                         throw std::runtime_error("Unknown optimization type");
                     }
@@ -1537,6 +1843,9 @@ lbool optimize_and_solve(SimpSolver& S, const vec<Lit>& assumes, const vec<Objec
                     }else if(opt_optimization_search_type == 2){
                         val = optimize_binary_pb(&S, pbSolver, objectives[i].maximize, assume, objectives[i],
                                                  hit_cutoff, n_solves, ever_solved);
+                    }else if(opt_optimization_search_type == 3){
+                        val = optimize_core_pb(&S, objectives[i].maximize, assume, objectives[i], hit_cutoff,
+                                               n_solves, ever_solved);
                     }else{
                         throw std::runtime_error("Unknown optimization type");
                     }
@@ -1600,9 +1909,9 @@ lbool optimize_and_solve(SimpSolver& S, const vec<Lit>& assumes, const vec<Objec
                 for(int j = 0; j < i; j++){
                     if(objectives[j].isBV()){
                         int bvID = objectives[j].bvID;
-                        int64_t best_value = objectives[i].maximize ? max_values[j] : min_values[j];
+                        int64_t best_value = objectives[j].maximize ? max_values[j] : min_values[j];
                         int64_t model_val = model_vals[j];
-                        if(lt(best_value, model_val, objectives[i].maximize)){
+                        if(lt(best_value, model_val, objectives[j].maximize)){
                             throw std::runtime_error(
                                     "Error in optimization (best values are inconsistent with model for bv " +
                                     std::to_string(j) + " (bvid " + std::to_string(bvID) + " ): expected value <= " +
@@ -1622,19 +1931,19 @@ lbool optimize_and_solve(SimpSolver& S, const vec<Lit>& assumes, const vec<Objec
                             }
                         }
                     }else{
-                        int64_t best_value = objectives[i].maximize ? max_values[j] : min_values[j];
+                        int64_t best_value = objectives[j].maximize ? max_values[j] : min_values[j];
                         int64_t model_val = model_vals[j];
-                        if(lt(best_value, model_val, objectives[i].maximize)){
+                        if(lt(best_value, model_val, objectives[j].maximize)){
                             throw std::runtime_error(
                                     "Error in optimization (best values are inconsistent with model for pb " +
                                     std::to_string(j) + " ): expected value <= " +
                                     std::to_string(best_value) + ", found " + std::to_string(model_val) + ")");
-                        }else if(lt(model_val, best_value, objectives[i].maximize)){
+                        }else if(lt(model_val, best_value, objectives[j].maximize)){
                             //if the best known value for any earlier bitvector, (which can happen if optimization is aborted early),
                             //is found, enforce that this improved value must be kept in the future.
                             Lit decision_lit = pbSolver->addConditionalConstr(objectives[j].pb_lits,
                                                                               objectives[j].pb_weights, model_val,
-                                                                              objectives[i].maximize ? PB::Ineq::GEQ
+                                                                              objectives[j].maximize ? PB::Ineq::GEQ
                                                                                                      : PB::Ineq::LEQ);
                             assume.push(decision_lit);
                             if(objectives[j].maximize){
@@ -0,0 +1,57 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2026, The MonoSAT Contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+
+#include "monosat/core/Proof.h"
+#include <cinttypes>
+
+using namespace Monosat;
+
+ProofWriter::ProofWriter(FILE* file, bool binary) : file(file), binary(binary){
+    buffer.reserve(buffer_size + 1024);
+}
+
+ProofWriter::~ProofWriter(){
+    flush();
+    fclose(file);
+}
+
+void ProofWriter::writeUnsigned(uint64_t x){
+    while(x > 127){
+        writeByte(128 | (x & 127));
+        x >>= 7;
+    }
+    writeByte(x);
+}
+
+void ProofWriter::writeText(int64_t x){
+    char digits[24];
+    int n = snprintf(digits, sizeof(digits), "%" PRId64 " ", x);
+    buffer.insert(buffer.end(), digits, digits + n);
+}
+
+void ProofWriter::flush(){
+    if(buffer.size() > 0){
+        fwrite(buffer.data(), 1, buffer.size(), file);
+        buffer.clear();
+    }
+    fflush(file);
+}
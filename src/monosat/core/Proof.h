@@ -0,0 +1,128 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2026, The MonoSAT Contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+
+#ifndef MONOSAT_PROOF_H
+#define MONOSAT_PROOF_H
+
+#include "monosat/core/SolverTypes.h"
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace Monosat {
+
+/**
+ * Writes a clausal proof of unsatisfiability, in DRAT format (binary or text), extended with two kinds of steps
+ * for clauses that a DRAT checker cannot derive on its own:
+ *
+ *  o <lits> 0                          an original clause, as given to the solver
+ *  a <lits> 0                          a clause derived by unit propagation or resolution (standard DRAT)
+ *  d <lits> 0                          a deleted clause (standard DRAT)
+ *  t <theory> <source> <lits> 0 <witness> 0
+ *                                      a trusted theory lemma: 'theory' is the index of the theory that produced it
+ *                                      (-1 if unknown), 'source' identifies the part of the theory that produced it
+ *                                      (for example, a graph detector; -1 if none), and 'witness' is a list of
+ *                                      theory-specific ids (such as the edges of a cut or path) supporting it.
+ *
+ * Variables are numbered as inside the solver (which may differ from the input file's numbering, if variables are
+ * remapped); since every original clause is recorded, the proof is self-contained.
+ * In text mode, added clauses are written without the 'a' prefix, as in text DRAT.
+ * Theory indices, sources and witness values are written as value+1 (so that 0 only ever terminates a list).
+ * In binary mode, each step begins with the step's character, and literals are encoded as 2*var+sign (with 1-based
+ * variables), all as variable length unsigned integers, as in binary DRAT.
+ * Output is buffered, and only written to the file when the buffer fills or flush() is called.
+ */
+class ProofWriter {
+    FILE* file;
+    bool binary;
+    std::vector<unsigned char> buffer;
+    static const size_t buffer_size = 1 << 20;
+
+    void writeByte(unsigned char c){
+        buffer.push_back(c);
+    }
+
+    void writeUnsigned(uint64_t x);
+
+    void writeText(int64_t x);
+
+public:
+    int64_t stats_steps = 0;
+
+    //Takes ownership of 'file', closing it when destroyed.
+    ProofWriter(FILE* file, bool binary);
+
+    ~ProofWriter();
+
+    void beginStep(char type){
+        stats_steps++;
+        if(binary){
+            writeByte(type);
+        }else if(type != 'a'){
+            //as in text DRAT, added clauses have no prefix
+            writeByte(type);
+            writeByte(' ');
+        }
+    }
+
+    //Write a literal (with 1-based variables)
+    void writeLit(Lit l){
+        if(binary){
+            writeUnsigned(2 * (uint64_t) (var(l) + 1) + sign(l));
+        }else{
+            writeText(sign(l) ? -(var(l) + 1) : (var(l) + 1));
+        }
+    }
+
+    //Write a theory index, source or witness value (-1 or greater), offset by one
+    void writeInt(int x){
+        if(binary){
+            writeUnsigned((uint64_t) (x + 1));
+        }else{
+            writeText(x + 1);
+        }
+    }
+
+    //Terminate a list of literals or witness values
+    void endList(){
+        if(binary){
+            writeByte(0);
+        }else{
+            writeByte('0');
+            writeByte(' ');
+        }
+    }
+
+    void endStep(){
+        if(!binary){
+            buffer.back() = '\n';
+        }
+        if(buffer.size() >= buffer_size){
+            flush();
+        }
+    }
+
+    void flush();
+};
+}
+
+#endif //MONOSAT_PROOF_H
@@ -83,6 +83,7 @@ Solver::~Solver(){
         delete (t);
     }
     delete pbsolver;
+    delete proof;
 }
 
 const std::string Solver::empty_name = "";
@@ -107,6 +108,9 @@ Var Solver::newVar(bool sign, bool dvar){
         activity.push();
         seen.push(0);
         polarity.push();
+        original_polarity.push();
+        target_polarity.push();
+        best_polarity.push();
         decision.push();
         trail.capacity(v + 1);
     }
@@ -125,6 +129,9 @@ Var Solver::newVar(bool sign, bool dvar){
     activity[v] = (rnd_init_act ? drand(random_seed) * 0.00001 : 0);
     seen[v] = 0;
     polarity[v] = opt_init_rnd_phase ? irand(random_seed, 1) : sign;
+    original_polarity[v] = polarity[v];
+    target_polarity[v] = polarity[v];
+    best_polarity[v] = polarity[v];
     //decision.push();//set below
 
     if(max_decision_var > 0 && v > max_decision_var)
@@ -168,7 +175,7 @@ void Solver::checkClause(vec<Lit>& clause){
 #endif
 }
 
-bool Solver::addClause_(vec<Lit>& ps, bool is_derived_clause){
+bool Solver::addClause_(vec<Lit>& ps, bool is_derived_clause, bool proof_logged){
 
 
     assert(decisionLevel() == 0);
@@ -179,6 +186,12 @@ bool Solver::addClause_(vec<Lit>& ps, bool is_derived_clause){
             resetInitialPropagation();    //Ensure that super solver call propagate on this solver at least once.
         }
     }
+    if(proof){
+        if(!proof_logged){
+            proofClause('o', ps);
+        }
+        ps.copyTo(proof_lemma);
+    }
     // Check if clause is satisfied and remove false/duplicate literals:
     sort(ps);
     Lit p;
@@ -189,6 +202,11 @@ bool Solver::addClause_(vec<Lit>& ps, bool is_derived_clause){
         else if(value(ps[i]) != l_False && ps[i] != p)
             ps[j++] = p = ps[i];
     ps.shrink(i - j);
+    if(proof && ps.size() < proof_lemma.size()){
+        //replace the clause with its simplification by the level 0 assignment
+        proofClause('a', ps);
+        proofClause('d', proof_lemma);
+    }
     checkClause(ps);
     if(ps.size() == 0)
         return ok = false;
@@ -234,6 +252,9 @@ CRef Solver::attachReasonClause(Lit r, vec<Lit>& ps){
         else if((value(ps[i]) != l_False || level(var(ps[i])) != 0) && ps[i] != p)
             ps[j++] = p = ps[i];
     ps.shrink(i - j);
+    if(proof && i > j){
+        proofClause('a', ps);
+    }
 
     CRef confl_out = CRef_Undef;
     if(ps.size() == 0){
@@ -410,6 +431,9 @@ void Solver::detachClause(CRef cr, bool strict){
 void Solver::removeClause(CRef cr){
     CRef remove_clause = cr;
     Clause& c = ca[cr];
+    if(proof && !proof_skip_deletes){
+        proofClause('d', c);
+    }
     detachClause(cr);
     // Don't leave pointers to free'd memory!
     if(locked(c))
@@ -428,15 +452,25 @@ bool Solver::satisfied(const Clause& c) const{
 // Revert to the state at given level (keeping all assignment at 'level' but not beyond).
 //
 void Solver::cancelUntil(int lev){
+    if(assumption_trail.size() > lev){
+        assumption_trail.shrink(assumption_trail.size() - lev);
+    }
     if(decisionLevel() > lev){
 
         for(int i = 0; i < theories.size(); i++){
             if(opt_lazy_backtrack && theories[i]->supportsLazyBacktracking()){
                 //if we _are_ backtracking lazily, then the assumption is that the theory solver will, after backtracking, mostly re-assign the same literals.
                 //so instead, we will backtrack the theory lazily, in the future, if it encounters an apparent conflict (and this backtracking may alter or eliminate that conflict.)
+            }else if(opt_skip_theory_backtrack && theory_max_level[i] <= lev &&
+                     theories[i]->supportsSkippingBacktrack()){
+                //this theory hasn't seen any literals above lev, so has nothing to undo
+                stats_skipped_theory_backtracks++;
             }else{
                 theories[i]->backtrackUntil(lev);
             }
+            if(theory_max_level[i] > lev){
+                theory_max_level[i] = lev;
+            }
         }
 
         //printf("s: cancel %d\n",lev);
@@ -646,7 +680,118 @@ Lit Solver::pickBranchLit(){
         }else
             next = order_heap.removeMin();
 
-    return next == var_Undef ? lit_Undef : mkLit(next, rnd_pol ? drand(random_seed) < 0.5 : polarity[next]);
+    if(next == var_Undef){
+        return lit_Undef;
+    }else if(rnd_pol){
+        return mkLit(next, drand(random_seed) < 0.5);
+    }else if(stable_mode && opt_target_phases){
+        return mkLit(next, target_polarity[next]);
+    }else{
+        return mkLit(next, polarity[next]);
+    }
+}
+
+void Solver::updatePhases(int n_consistent){
+    if(stable_mode && opt_target_phases && n_consistent > target_assigned){
+        for(int i = 0; i < n_consistent; i++){
+            target_polarity[var(trail[i])] = sign(trail[i]);
+        }
+        target_assigned = n_consistent;
+    }
+    if(opt_rephase > 0 && n_consistent > best_assigned){
+        for(int i = 0; i < n_consistent; i++){
+            best_polarity[var(trail[i])] = sign(trail[i]);
+        }
+        best_assigned = n_consistent;
+    }
+}
+
+void Solver::rephase(){
+    //Rephase in the order original, inverted, followed by best, original, best, inverted, repeated
+    //(or, with local search enabled, best, walk, original, best, walk, inverted, repeated).
+    const char* schedule = opt_walk ? "BWOBWI" : "BOBI";
+    int schedule_len = strlen(schedule);
+    char type = n_rephases < 2 ? "OI"[n_rephases] : schedule[(n_rephases - 2) % schedule_len];
+    n_rephases++;
+    if(type == 'W'){
+        //start the walk from the best assignment
+        for(Var v = 0; v < nVars(); v++){
+            polarity[v] = best_polarity[v];
+        }
+        walkPhases();
+    }
+    for(Var v = 0; v < nVars(); v++){
+        if(type == 'O'){
+            polarity[v] = original_polarity[v];
+        }else if(type == 'I'){
+            polarity[v] = !original_polarity[v];
+        }else if(type == 'B'){
+            polarity[v] = best_polarity[v];
+        }
+        target_polarity[v] = polarity[v];
+    }
+    if(type == 'O'){
+        stats_rephases_original++;
+    }else if(type == 'I'){
+        stats_rephases_inverted++;
+    }else if(type == 'B'){
+        stats_rephases_best++;
+    }else{
+        stats_rephases_walk++;
+    }
+    target_assigned = 0;
+    best_assigned = 0;
+}
+
+void Solver::walkPhases(){
+    //Build the Boolean skeleton: the problem clauses, simplified by the level 0 assignment.
+    //Theory atoms are just unconstrained variables here, so the walk can only hint at their phases.
+    double start_time = cpuTime();
+    local_search.clear(nVars());
+    for(CRef cr:clauses){
+        const Clause& c = ca[cr];
+        if(c.mark()){
+            continue;
+        }
+        walk_clause.clear();
+        bool satisfied = false;
+        for(int i = 0; i < c.size(); i++){
+            Lit l = c[i];
+            if(value(l) != l_Undef && level(var(l)) == 0){
+                if(value(l) == l_True){
+                    satisfied = true;
+                    break;
+                }
+            }else{
+                walk_clause.push(l);
+            }
+        }
+        if(!satisfied && walk_clause.size() > 0){
+            local_search.addClause(walk_clause);
+        }
+    }
+    int64_t max_flips = (int64_t) (opt_walk_effort * local_search.nClauses());
+    stats_last_walk_unsat = local_search.walk(polarity, max_flips, opt_walk_time);
+    for(Var v = 0; v < nVars(); v++){
+        target_polarity[v] = polarity[v];
+    }
+    stats_walks++;
+    stats_walk_time += cpuTime() - start_time;
+}
+
+int Solver::nextRestartInterval(int curr_restarts){
+    double interval;
+    if(stable_mode){
+        interval = luby(restart_inc, stable_restarts) * opt_stable_restart_first;
+    }else{
+        double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
+        interval = rest_base * restart_first;
+    }
+    if(opt_stable_mode && conflicts + interval > next_mode_switch){
+        //end this search early, at the mode switch
+        interval = next_mode_switch > conflicts ? next_mode_switch - conflicts : 1;
+    }
+    return (int) interval;
 }
 
 void Solver::instantiateLazyDecision(Lit p, int atLevel, CRef reason){
@@ -1072,6 +1217,12 @@ void Solver::analyzeFinal(Lit p, vec<Lit>& out_conflict){
 
 void Solver::enqueueLazy(Lit p, int lev, CRef from){
     assert(value(p) != l_False);
+    if(proof && lev == 0 && isTheoryCause(from) && !isDecisionReason(from) && (value(p) == l_Undef || level(var(p)) > 0)){
+        //theory implications at level 0 are never explained by a reason clause, so record them as theory lemmas
+        proof_lemma.clear();
+        proof_lemma.push(p);
+        proofTheoryLemma(getTheory(from), proof_lemma);
+    }
     if(value(p) == l_True && lev < level(var(p))){
         //then the lit was already implied, but needs to be (lazily) moved to an earlier level.
         vardata[var(p)] = mkVarData(from, lev);
@@ -1099,6 +1250,12 @@ void Solver::enqueueLazy(Lit p, int lev, CRef from){
 
 void Solver::uncheckedEnqueue(Lit p, CRef from){
     assert(value(p) == l_Undef);
+    if(proof && decisionLevel() == 0 && isTheoryCause(from) && !isDecisionReason(from)){
+        //theory implications at level 0 are never explained by a reason clause, so record them as theory lemmas
+        proof_lemma.clear();
+        proof_lemma.push(p);
+        proofTheoryLemma(getTheory(from), proof_lemma);
+    }
     assigns[var(p)] = lbool(!sign(p));
     vardata[var(p)] = mkVarData(from, decisionLevel());
     trail.push_(p);
@@ -1322,7 +1479,7 @@ void Solver::enqueueAnyUnqueued(){
             int start = post_satisfied_theory_trail_pos[theoryID];
             if(start >= 0 && start <= i){
                 Theory* theory = theories[theoryID];
-
+                touchTheory(theoryID);
                 theory->enqueueTheory(l);
                 assert(post_satisfied_theory_trail_pos[theoryID] <= i);
                 post_satisfied_theory_trail_pos[theoryID] = i;
@@ -1526,9 +1683,12 @@ bool Solver::propagateTheorySolver(int theoryID, CRef& confl, vec<Lit>& theory_c
     theory_conflict.clear();
     //todo: ensure that the bv theory comes first, as otherwise dependent theories may have to be propagated twice...
 
-
+    touchTheory(theoryID);
     if(!theories[theoryID]->propagateTheory(theory_conflict)){
         bool has_conflict = true;
+        if(proof){
+            proofTheoryLemma(theories[theoryID], theory_conflict);
+        }
 #ifdef DEBUG_CORE
         for(Lit l:theory_conflict)
             assert(value(l) != l_Undef);
@@ -1822,9 +1982,13 @@ void Solver::addClauseSafely(vec<Lit>& ps){
         fprintf(opt_write_learnt_clauses, " 0\n");
         fflush(opt_write_learnt_clauses);
     }
+    if(proof){
+        //clauses added this way come from theories (or the optimizer), but which one isn't known here
+        proofTheoryLemma(nullptr, ps);
+    }
 
     if(decisionLevel() == 0){
-        addClause_(ps, true);
+        addClause_(ps, true, true);
     }else{
         //clauses_to_add.push();
         //ps.copyTo(clauses_to_add.last());
@@ -1850,6 +2014,9 @@ void Solver::addClauseSafely(vec<Lit>& ps){
             }
         }
         ps.shrink(i - j);
+        if(proof && i > j){
+            proofClause('a', ps);
+        }
         if(false_count == ps.size() - 1){
             //this clause is unit under the current assignment.
             //although we _could_ wait until a restart to add this clause, in many cases this will lead to very poor solver behaviour.
@@ -1958,6 +2125,9 @@ bool Solver::addConflictClause(vec<Lit>& ps, CRef& confl_out, bool permanent){
 
     }
     ps.shrink(i - j);
+    if(proof && i > j){
+        proofClause('a', ps);
+    }
 /*	if(any_undef){
 		cancelUntil(0);//this is _not_ a conflict clause.
 	}*/
@@ -2139,6 +2309,11 @@ lbool Solver::search(int nof_conflicts){
 
     bool propagate_theories_during_assumptions = opt_theory_propagate_assumptions;
 
+    bool use_chrono = opt_chrono >= 0;
+    for(int i = 0; i < theories.size() && use_chrono; i++){
+        use_chrono = theories[i]->supportsChronologicalBacktracking();
+    }
+
     if(decisionLevel() == 0 && initialPropagate && opt_detect_pure_lits && !simplify()){
         return l_False;//if using pure literal detection, and the theories haven't been propagated yet, run simpify
     }
@@ -2227,6 +2402,10 @@ lbool Solver::search(int nof_conflicts){
                 return l_False;
             learnt_clause.clear();
             analyze(confl, learnt_clause, backtrack_level);
+            if(opt_stable_mode && decisionLevel() > 0){
+                //analyze() backtracks to the highest level in the conflict, so everything below that level is conflict free
+                updatePhases(trail_lim.last());
+            }
 
             int lowest_conflicting_decision_level = decisionLevel();
             if(last_decision_heuristic && (!conflicting_heuristic || conflicting_heuristic->getPriority() <
@@ -2421,7 +2600,16 @@ lbool Solver::search(int nof_conflicts){
                 }
             }
 
-            cancelUntil(backtrack_level);
+            //Chronological backtracking (Nadel & Ryvchin, 2018): if the learnt clause would backjump over many levels,
+            //only undo the conflict level, and assign the asserting literal out of order, at the level it would
+            //have been implied at. Most of the undone trail would otherwise be re-derived identically.
+            bool chrono = use_chrono && learnt_clause.size() > 1 && decisionLevel() - backtrack_level > opt_chrono;
+            if(chrono){
+                stats_chrono_backtracks++;
+                cancelUntil(decisionLevel() - 1);
+            }else{
+                cancelUntil(backtrack_level);
+            }
 
             if(opt_theory_order_swapping && order_changed){
                 //rebuild the theory order queue
@@ -2432,6 +2620,9 @@ lbool Solver::search(int nof_conflicts){
             //this is now slightly more complicated, if there are multiple lits implied by the super solver in the current decision level:
             //The learnt clause may not be asserting.
 
+            if(proof){
+                proofClause('a', learnt_clause);
+            }
             if(learnt_clause.size() == 1){
                 uncheckedEnqueue(learnt_clause[0]);
             }else{
@@ -2441,7 +2632,11 @@ lbool Solver::search(int nof_conflicts){
                 claBumpActivity(ca[cr]);
 
                 if(value(learnt_clause[0]) == l_Undef){
-                    uncheckedEnqueue(learnt_clause[0], cr);
+                    if(chrono){
+                        enqueueLazy(learnt_clause[0], backtrack_level, cr);
+                    }else{
+                        uncheckedEnqueue(learnt_clause[0], cr);
+                    }
                 }else{
 
                     assert(S);
@@ -2624,6 +2819,9 @@ lbool Solver::search(int nof_conflicts){
             if((opt_restarts && (nof_conflicts >= 0 && conflictC >= nof_conflicts)) || !withinBudget()){
                 // Reached bound on number of conflicts:
                 progress_estimate = progressEstimate();
+                if(opt_stable_mode){
+                    updatePhases(trail.size());
+                }
                 cancelUntil(initial_level);
                 return l_Undef;
             }
@@ -2788,6 +2986,13 @@ lbool Solver::search(int nof_conflicts){
 */
                 if(next != lit_Undef){
                     stats_theory_decisions++;
+                    if(stable_mode && opt_target_theory_decisions &&
+                       (theoryDecision == lit_Undef || var(next) != var(theoryDecision))){
+                        next = mkLit(var(next), target_polarity[var(next)]);
+                    }
+                    if(next_decision_heuristic && next_decision_heuristic->getTheoryIndex() >= 0){
+                        touchTheory(next_decision_heuristic->getTheoryIndex());
+                    }
                     if(theoryDecision != lit_Undef && var(next) == var(theoryDecision)){
                         assigns[var(theoryDecision)] = l_Undef;
                     }
@@ -2838,7 +3043,11 @@ lbool Solver::search(int nof_conflicts){
                         for(int i = 0; i < theories.size(); i++){
                             if(opt_subsearch == 3 && track_min_level < initial_level)
                                 continue; //Disable attempting to solve sub-solvers if we've backtracked past the super solver's decision level
+                            touchTheory(i);
                             if(!theories[i]->solveTheory(theory_conflict)){
+                                if(proof){
+                                    proofTheoryLemma(theories[i], theory_conflict);
+                                }
                                 if(!addConflictClause(theory_conflict, confl)){
                                     goto conflict;
                                 }else{
@@ -2916,6 +3125,23 @@ lbool Solver::solveUntilRestart(const vec<Lit>& assumps){
     return val;
 }
 
+void Solver::cancelUntilAssumptions(const vec<Lit>& assumps){
+    int reuse = 0;
+    //Theory solvers may need to see new atoms or constants at level 0 before the next search, which requires a full backtrack
+    if(opt_reuse_assumptions && !initialPropagate && ok){
+        while(reuse < assumption_trail.size() && reuse < assumps.size() && assumption_trail[reuse] == assumps[reuse]){
+            reuse++;
+        }
+        if(!opt_theory_propagate_assumptions && reuse < assumption_trail.size()){
+            //without theory propagation during assumptions, the theories only propagated the previous assumptions once
+            //all of them were assigned, at the last assumption level; so a strict prefix of them cannot be kept.
+            reuse = 0;
+        }
+    }
+    cancelUntil(reuse);
+    last_reused_assumptions = reuse;
+}
+
 // NOTE: assumptions passed in member-variable 'assumptions'.
 lbool Solver::solve_(){
 #ifndef NDEBUG
@@ -2931,14 +3157,20 @@ lbool Solver::solve_(){
     }
 #endif
     clearInterrupt();
-    cancelUntil(0);
+    cancelUntilAssumptions(assumptions);
     model.clear();
     conflict.clear();
-    if(!ok)
+    if(!ok){
+        proofResult(l_False);
         return l_False;
+    }
     if(pbsolver){
-        pbsolver->convert();
+        pbsolver->convert();//if this adds any clauses, the solver will backtrack to level 0
+    }
+    if(decisionLevel() < last_reused_assumptions){
+        last_reused_assumptions = decisionLevel();
     }
+    stats_reused_assumptions += last_reused_assumptions;
 
     solves++;
 
@@ -2959,7 +3191,9 @@ lbool Solver::solve_(){
     track_min_level = 0;
     //ensure that any theory atoms that were created _after_ the variable was assigned are enqueued in the theory
     //this can be improved
-    for(int i = 0; i < qhead; i++){
+    //(if any assumptions are still assigned from the previous solve, then no atoms have been created since then,
+    //as that would have forced a backtrack to level 0)
+    for(int i = 0; i < qhead && decisionLevel() == 0; i++){
         Lit p = trail[i];
         for(int n = 0; n < getNTheories(var(p)); n++){
             int theoryID = getTheoryID(p, n);
@@ -2974,8 +3208,34 @@ lbool Solver::solve_(){
     }
 
 
+    if(opt_stable_mode && mode_switch_interval == 0){
+        mode_switch_interval = opt_stable_first;
+        next_mode_switch = conflicts + opt_stable_first;
+    }
+    if(opt_rephase > 0 && next_rephase == 0){
+        next_rephase = conflicts + opt_rephase;
+    }
+    if(opt_walk && opt_walk_initial && !walked_initial){
+        walked_initial = true;
+        walkPhases();
+    }
+
     while(status == l_Undef){
-        double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
+        if(opt_stable_mode && conflicts >= next_mode_switch){
+            //alternate between focused and stable search, doubling (by default) the length of each pair of phases
+            stable_mode = !stable_mode;
+            stats_mode_switches++;
+            if(!stable_mode){
+                mode_switch_interval *= opt_stable_inc;
+            }
+            next_mode_switch = conflicts + (uint64_t) mode_switch_interval;
+        }
+        if(opt_rephase > 0 && conflicts >= next_rephase){
+            rephase();
+            next_rephase = conflicts + (uint64_t) opt_rephase * (n_rephases + 1);
+        }
+        target_assigned = 0;
+        int restart_interval = nextRestartInterval(curr_restarts);
 
         if(opt_rnd_phase){
             for(int i = 0; i < nVars(); i++)
@@ -3010,7 +3270,7 @@ lbool Solver::solve_(){
         }
 
 
-        status = search(rest_base * restart_first);
+        status = search(restart_interval);
         if(verbosity >= 1){
             printf("|r%9d | %7d %8d %8d | %8d %8d %6.0f | %" PRId64 " removed |\n", (int) conflicts,
                    (int) dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]), nClauses(),
@@ -3033,7 +3293,11 @@ lbool Solver::solve_(){
             //printf("\n");
             break;
         }
-        curr_restarts++;
+        if(stable_mode){
+            stable_restarts++;
+        }else{
+            curr_restarts++;
+        }
         if(opt_rnd_restart && status == l_Undef){
 
             for(int i = 0; i < nVars(); i++){
@@ -3147,8 +3411,16 @@ lbool Solver::solve_(){
     }
     quit_at_restart = false;
     only_propagate_assumptions = false;
+    //levels 1..n were decided on the first n assumptions, and can be kept by the next solve if it starts with the same assumptions
+    assumptions.copyTo(assumption_trail);
+    if(!opt_theory_propagate_assumptions && decisionLevel() < assumption_trail.size()){
+        //the theories have not propagated the assigned assumptions (see cancelUntilAssumptions)
+        assumption_trail.clear();
+    }
+    assumption_trail.shrink(assumption_trail.size() - std::min(decisionLevel(), assumption_trail.size()));
     assumptions.clear();
     clearSatisfied();
+    proofResult(status);
     return status;
 }
 
@@ -3185,6 +3457,51 @@ bool Solver::solveTheory(vec<Lit>& conflict_out){
 }
 
 
+void Solver::setProofFile(const char* filename, bool binary){
+    FILE* file = fopen(filename, binary ? "wb" : "w");
+    if(!file){
+        throw std::runtime_error("Could not open proof file " + std::string(filename));
+    }
+    delete proof;
+    proof = new ProofWriter(file, binary);
+}
+
+void Solver::proofTheoryLemma(Theory* t, const vec<Lit>& lemma){
+    int source = -1;
+    proof_witness.clear();
+    if(t){
+        proof_theory_lits.clear();
+        for(Lit l:lemma){
+            if(theoryHasVar(var(l), t)){
+                proof_theory_lits.push(getTheoryLit(l, t));
+            }
+        }
+        source = t->explainLemma(proof_theory_lits, proof_witness);
+    }
+    proof->beginStep('t');
+    proof->writeInt(t ? t->getTheoryIndex() : -1);
+    proof->writeInt(source);
+    for(Lit l:lemma){
+        proof->writeLit(l);
+    }
+    proof->endList();
+    for(int w:proof_witness){
+        proof->writeInt(w);
+    }
+    proof->endList();
+    proof->endStep();
+}
+
+void Solver::proofResult(lbool status){
+    if(!proof){
+        return;
+    }
+    if(status == l_False){
+        proofClause('a', conflict.toVec());
+    }
+    proof->flush();
+}
+
 Var Solver::unmap(Var v){
     if(v >= nVars()){
         throw std::runtime_error("Cannot unmap non-existant variable: " + std::to_string(v));
@@ -33,6 +33,8 @@
 #include "monosat/core/Theory.h"
 #include "monosat/core/TheorySolver.h"
 #include "monosat/core/Config.h"
+#include "monosat/core/LocalSearch.h"
+#include "monosat/core/Proof.h"
 #include <cinttypes>
 #include <map>
 #include <string>
@@ -84,8 +86,12 @@ public:
     bool addClause(Lit p) override;                                  // Add a unit clause to the solver.
     bool addClause(Lit p, Lit q) override;                           // Add a binary clause to the solver.
     bool addClause(Lit p, Lit q, Lit r) override;                    // Add a ternary clause to the solver.
+    // Add n_clauses clauses, stored back to back in 'lits': clause i is lits[offsets[i]] .. lits[offsets[i+1]-1]
+    // (so offsets has n_clauses+1 entries). Space for all of them is reserved up front.
+    virtual bool addClauses(const vec<Lit>& lits, const int* offsets, int n_clauses);
     bool addClause_(vec<Lit>& ps,
-                    bool is_derived_clause = false);           // Add a clause to the solver without making superflous internal copy. Will
+                    bool is_derived_clause = false,
+                    bool proof_logged = false);           // Add a clause to the solver without making superflous internal copy. Will
 
     void disableElimination(Var v) override{
         //do nothing
@@ -158,6 +164,7 @@ public:
         theories.push(t);
         theory_reprop_trail_pos.push(-1);
         theory_init_prop_trail_pos.push(-1);
+        theory_max_level.push(0);
         t->setTheoryIndex(theories.size() - 1);
         if(t->supportsDecisions()){
             addHeuristic(t);
@@ -312,6 +319,31 @@ public:
         if(stats_skipped_theory_prop_rounds > 0){
             printf("theory propagations skipped: %" PRId64 "\n", stats_skipped_theory_prop_rounds);
         }
+        if(stats_skipped_theory_backtracks > 0){
+            printf("theory backtracks skipped: %" PRId64 "\n", stats_skipped_theory_backtracks);
+        }
+        if(stats_mode_switches > 0){
+            printf("stable mode switches  : %-12" PRIu64 "\n", stats_mode_switches);
+        }
+        if(stats_rephases_original + stats_rephases_inverted + stats_rephases_best + stats_rephases_walk > 0){
+            printf("rephases              : %-12" PRIu64 "   (%" PRIu64 " original, %" PRIu64 " inverted, %" PRIu64 " best, %" PRIu64 " walk)\n",
+                   stats_rephases_original + stats_rephases_inverted + stats_rephases_best + stats_rephases_walk,
+                   stats_rephases_original, stats_rephases_inverted, stats_rephases_best, stats_rephases_walk);
+        }
+        if(stats_walks > 0){
+            printf("local search walks    : %-12" PRIu64 "   (%" PRId64 " flips, %d unsat clauses after last walk, %f s)\n",
+                   stats_walks, local_search.stats_flips, stats_last_walk_unsat, stats_walk_time);
+        }
+        if(stats_chrono_backtracks > 0){
+            printf("chronological backtracks: %" PRId64 "\n", stats_chrono_backtracks);
+        }
+        if(proof){
+            printf("proof steps           : %-12" PRId64 "\n", proof->stats_steps);
+        }
+        if(stats_reused_assumptions > 0){
+            printf("reused assumptions    : %-12" PRIu64 "   (%d in the last solve)\n", stats_reused_assumptions,
+                   last_reused_assumptions);
+        }
         if(opt_detect_pure_theory_lits){
             printf("pure literals     : %" PRId64 " (%" PRId64 " theory lits) (%" PRId64 " rounds, %f time)\n",
                    stats_pure_lits,
@@ -492,7 +524,20 @@ public:
         }
     }
 
+    bool hasPendingConstraints() override{
+        for(Theory* t:theories){
+            if(t->hasPendingConstraints())
+                return true;
+        }
+        return false;
+    }
+
+    //If a previous solve left assumptions assigned, this backtracks to level 0 first if any theory has constraints
+    //to implement.
     void preprocess() override{
+        if(decisionLevel() > 0 && hasPendingConstraints()){
+            cancelUntil(0);
+        }
         for(int i = 0;i<theories.size();i++){
             theories[i]->preprocess();
         }
@@ -517,8 +562,11 @@ public:
         theory_reason.clear();
 
         double start_t = rtime(1);
-
+        touchTheory(t->getTheoryIndex());
         t->buildReason(getTheoryLit(p, t), theory_reason, cr);
+        if(proof){
+            proofTheoryLemma(t, theory_reason);
+        }
 
         stats_theory_conflict_time += (rtime(1) - start_t);
         assert(theory_reason[0] == p);
@@ -650,6 +698,10 @@ public:
         return var(l) >= 0 && getLiteral(name) == l;
     }
 
+    //Write a proof of unsatisfiability to this file (see ProofWriter for the format).
+    //Should be called before any clauses are added.
+    void setProofFile(const char* filename, bool binary = true);
+
     //Associate variable v with a name.
     //If name is empty, then remove any existing name associated with v
     //If the variable already has this name, do nothing
@@ -783,6 +835,7 @@ public:
     int theory_index = 0;
     Solver* S = nullptr;                                //super solver
     Theory* bvtheory = nullptr;
+    Theory* amotheory = nullptr;
     PB::PBConstraintSolver* pbsolver = nullptr;
     bool initialPropagate = true;                    //to force propagation to occur at least once to the theory solvers
     int super_qhead = 0;
@@ -803,6 +856,7 @@ public:
     IntSet<int> unskippable_theory_q;
     vec<int> theory_reprop_trail_pos;
     vec<int> theory_init_prop_trail_pos;
+    vec<int> theory_max_level;//the highest decision level at which each theory was given (or produced, or explained) a literal
     bool disable_theories = false;
     int min_decision_var = 0;
     int max_decision_var = -1;
@@ -869,6 +923,18 @@ public:
     uint64_t stats_swapping_resets = 0;
     uint64_t stats_swapping_conflict_count = 0;
     uint64_t stats_theory_conflicts = 0;
+    uint64_t stats_skipped_theory_backtracks = 0;
+    uint64_t stats_chrono_backtracks = 0;
+    uint64_t stats_mode_switches = 0;
+    uint64_t stats_rephases_original = 0;
+    uint64_t stats_rephases_inverted = 0;
+    uint64_t stats_rephases_best = 0;
+    uint64_t stats_rephases_walk = 0;
+    uint64_t stats_walks = 0;
+    int stats_last_walk_unsat = 0;
+    double stats_walk_time = 0;
+    uint64_t stats_reused_assumptions = 0;
+    int last_reused_assumptions = 0;
     double stats_theory_prop_time = 0;
     double stats_theory_conflict_time = 0;
 
@@ -1032,6 +1098,25 @@ protected:
 
     vec<lbool> assigns;          // The current assignments.
     vec<char> polarity;         // The preferred polarity of each variable.
+    vec<char> original_polarity;// The initial (or user provided) polarity of each variable, restored when rephasing.
+    vec<char> target_polarity;  // The polarity of each variable in the largest conflict-free assignment since the last restart.
+    vec<char> best_polarity;    // The polarity of each variable in the largest conflict-free assignment since the last rephase.
+    int target_assigned = 0;    // Size of the assignment recorded in 'target_polarity'.
+    int best_assigned = 0;      // Size of the assignment recorded in 'best_polarity'.
+    bool stable_mode = false;   // If true, search is in the stable phase (long restarts, target phases).
+    uint64_t next_mode_switch = 0;
+    double mode_switch_interval = 0;
+    int stable_restarts = 0;
+    uint64_t next_rephase = 0;
+    int n_rephases = 0;
+    bool walked_initial = false;
+    LocalSearch local_search;
+    vec<Lit> walk_clause;
+    ProofWriter* proof = nullptr;
+    vec<Lit> proof_lemma;
+    vec<Lit> proof_theory_lits;
+    vec<int> proof_witness;
+    bool proof_skip_deletes = false;//set while a caller records its own clause deletions
     vec<char> decision;         // Declares if a variable is eligible for selection in the decision heuristic.
     vec<int> priority;          // Static, lexicographic heuristic. Larger values are higher priority (decided first).
 
@@ -1046,6 +1131,7 @@ protected:
     int simpDB_assigns;   // Number of top-level assignments since last execution of 'simplify()'.
     int64_t simpDB_props;   // Remaining number of propagations that must be made before next execution of 'simplify()'.
     vec<Lit> assumptions;      // Current set of assumptions provided to solve by the user.
+    vec<Lit> assumption_trail; // The assumptions that were decided at decision levels 1..assumption_trail.size(), left assigned by the previous solve.
     bool only_propagate_assumptions = false; //true if the solver should propagate assumptions and then quit without solving
     bool quit_at_restart = false;//true if the solver should give up as soon as it restarts
     int override_restart_count = -1;
@@ -1118,6 +1204,15 @@ public:
         return bvtheory;
     }
 
+    //All at-most-one constraints in this solver share a single AMO theory (see AMOTheory::getAMOTheory())
+    void setAMOTheory(Theory* t){
+        amotheory = t;
+    }
+
+    Theory* getAMOTheory(){
+        return amotheory;
+    }
+
     void setPBSolver(PB::PBConstraintSolver* t){
         pbsolver = t;
     }
@@ -1162,7 +1257,22 @@ public:
 
     // void unsafeUnassign(Lit p);
     void cancelUntil(int level);                                             // Backtrack until a certain level.
+    void cancelUntilAssumptions(const vec<Lit>& assumps);                    // Backtrack to the longest prefix of 'assumps' that is still assigned from the previous solve.
+
+    //Number of leading assumptions that were still assigned from the previous solve, and so did not need to be re-propagated
+    int nReusedAssumptions() const{
+        return last_reused_assumptions;
+    }
+    //Record that the theory may have changed its state at the current decision level,
+    //so that it will be backtracked if the solver backtracks below this level.
+    inline void touchTheory(int theoryID){
+        if(theory_max_level[theoryID] < decisionLevel()){
+            theory_max_level[theoryID] = decisionLevel();
+        }
+    }
+
     inline void needsPropagation(int theoryID) override{
+        touchTheory(theoryID);
         if(theories[theoryID]->unskipable()){
             unskippable_theory_q.insert(theoryID);
         }else{
@@ -1176,6 +1286,29 @@ public:
     }
 
 protected:
+    //Reserve space for n_clauses more original clauses, with n_lits literals between them
+    void reserveClauses(int n_clauses, int64_t n_lits){
+        ca.reserve(n_clauses, n_lits);
+        clauses.capacity(clauses.size() + n_clauses);
+    }
+
+    //Write a proof step ('o'riginal, 'a'dded, or 'd'eleted) for this clause
+    template<class Lits>
+    void proofClause(char type, const Lits& lits){
+        proof->beginStep(type);
+        for(int i = 0; i < lits.size(); i++){
+            proof->writeLit(lits[i]);
+        }
+        proof->endList();
+        proof->endStep();
+    }
+
+    //Write a trusted theory lemma (from theory 't', or from an unknown source if 't' is null) to the proof
+    void proofTheoryLemma(Theory* t, const vec<Lit>& lemma);
+
+    //If this solve was unsatisfiable, add its final conflict clause (or the empty clause) to the proof, and flush it
+    void proofResult(lbool status);
+
     void analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel);    // (bt = backtrack)
     void analyzeFinal(CRef confl, Lit skip_lit, vec<Lit>& out_conflict);
 
@@ -1200,6 +1333,10 @@ protected:
 
     bool litRedundant(Lit p, uint32_t abstract_levels);                       // (helper method for 'analyze()')
     lbool search(int nof_conflicts);                                     // Search for a given number of conflicts.
+    void updatePhases(int n_consistent);                     // Record the first 'n_consistent' trail lits as target/best phases.
+    void rephase();                                        // Reset the saved phases (original, inverted, or best assignment).
+    void walkPhases();                                     // Set the saved phases by local search over the problem clauses.
+    int nextRestartInterval(int curr_restarts);           // Conflicts until the next restart (or stable mode switch).
     lbool solve_();                                           // Main solve method (assumptions given in 'assumptions').
     void reduceDB();                                                      // Reduce the set of learnt clauses.
     void removeSatisfied(vec<CRef>& cs);                           // Shrink 'cs' to contain only non-satisfied clauses.
@@ -1546,6 +1683,18 @@ inline bool Solver::addClause(const vec<Lit>& ps){
     return addClause_(add_tmp);
 }
 
+inline bool Solver::addClauses(const vec<Lit>& lits, const int* offsets, int n_clauses){
+    cancelUntil(0);
+    reserveClauses(n_clauses, offsets[n_clauses] - offsets[0]);
+    for(int i = 0; i < n_clauses && ok; i++){
+        add_tmp.clear();
+        for(int j = offsets[i]; j < offsets[i + 1]; j++)
+            add_tmp.push(lits[j]);
+        addClause_(add_tmp);
+    }
+    return ok;
+}
+
 inline bool Solver::addEmptyClause(){
     cancelUntil(0);
     add_tmp.clear();
@@ -1653,6 +1802,9 @@ inline bool Solver::hasNextDecision() const{
 
 inline void Solver::setPolarity(Var v, bool b){
     polarity[v] = b;
+    original_polarity[v] = b;
+    target_polarity[v] = b;
+    best_polarity[v] = b;
 }
 
 inline void Solver::setDecisionVar(Var v, bool b){
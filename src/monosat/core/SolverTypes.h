@@ -399,6 +399,12 @@ public:
         return cid;
     }
 
+    // Make sure that n_clauses more (original) clauses, with n_lits literals between them, can be allocated
+    // without moving the region.
+    void reserve(int n_clauses, int64_t n_lits){
+        RegionAllocator<uint32_t>::reserve((uint64_t) n_clauses * clauseWord32Size(0, extra_clause_field) + n_lits);
+    }
+
     // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
     Clause& operator[](Ref r){
         return (Clause&) RegionAllocator<uint32_t>::operator[](r);
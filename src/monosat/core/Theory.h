@@ -100,6 +100,30 @@ public:
         return false;
     }
 
+    //Return true if the solver can skip calling backtrackUntil(level) on this theory when it has not been given, or propagated,
+    //any literals above that level. Theories whose state can change without the solver being involved
+    //(for example, because they are driven by another theory solver) must return false.
+    virtual bool supportsSkippingBacktrack(){
+        return false;
+    }
+
+    //Return true if this theory accepts literals that the solver assigns below the theory's current decision level
+    //(as happens with chronological backtracking, where the asserting literal of a learnt clause is assigned at its
+    //backjump level without first backtracking to that level), and keeps its state consistent when the solver later
+    //backtracks to a level between the two.
+    virtual bool supportsChronologicalBacktracking(){
+        return false;
+    }
+
+    //For proof logging: describe the lemma (conflict clause, reason, or implied literal) this theory most recently
+    //produced. 'lemma' holds the lemma's literals that belong to this theory (as theory literals).
+    //Returns the id of the part of the theory that produced it (or -1), and fills 'witness' with theory-specific ids
+    //supporting it (for example, the edges of a cut or path).
+    virtual int explainLemma(const vec<Lit>& lemma, vec<int>& witness){
+        witness.clear();
+        return -1;
+    }
+
     //Not all theories have a name; if they do not, they can just return the empty string.
     virtual const std::string& getName(){
         static const std::string empty("");
@@ -139,6 +163,12 @@ public:
         //do nothing
     }
 
+    //Return true if this theory has constraints or atoms that its next preprocess() call will implement
+    //(and which therefore must be added at level 0).
+    virtual bool hasPendingConstraints(){
+        return false;
+    }
+
     virtual void preprocess(){
 
     }
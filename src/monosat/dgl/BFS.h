@@ -440,8 +440,6 @@ public:
     }
 
     void update() override{
-        static int iteration = 0;
-        int local_it = ++iteration;
 
         if(last_modification > 0 && g.getCurrentHistory() == last_modification){
             stats_skipped_updates++;
@@ -801,8 +799,6 @@ public:
     }
 
     void update() override{
-        static int iteration = 0;
-        int local_it = ++iteration;
 
         if(last_modification > 0 && g.getCurrentHistory() == last_modification){
             stats_skipped_updates++;
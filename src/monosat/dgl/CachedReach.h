@@ -153,10 +153,6 @@ public:
         edge_in_path.clear();//clear and rebuild the path tree
         int source = getSource();
         assert(previous_edge[source] == -1);
-        static int iter = 0;
-        if(++iter == 25){
-            int a = 1;
-        };
         has_non_reach_destinations = false;
 
         bool randomShortestPath = alg::drand(random_seed) < randomShortestPathFrequency;
@@ -223,8 +219,6 @@ public:
     }
 
     void update() override{
-        static int iteration = 0;
-        int local_it = ++iteration;
 
         if(!needs_recompute && last_modification > 0 && g.getCurrentHistory() == last_modification){
             return;
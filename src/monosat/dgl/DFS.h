@@ -414,8 +414,6 @@ public:
     }
 
     void update() override{
-        static int iteration = 0;
-        int local_it = ++iteration;
 
         if(last_modification > 0 && g.getCurrentHistory() == last_modification){
             stats_skipped_updates++;
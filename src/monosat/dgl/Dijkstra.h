@@ -123,8 +123,6 @@ public:
     }
 
     void update() override{
-        static int iteration = 0;
-        int local_it = ++iteration;
 
         if(last_modification > 0 && g.getCurrentHistory() == last_modification)
             return;
@@ -496,8 +494,6 @@ public:
     }
 
     void update() override{
-        static int iteration = 0;
-        int local_it = ++iteration;
 
         if(last_modification > 0 && g.getCurrentHistory() == last_modification)
             return;
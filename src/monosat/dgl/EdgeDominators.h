@@ -0,0 +1,210 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2026, The MonoSAT Contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef EDGE_DOMINATORS_H_
+#define EDGE_DOMINATORS_H_
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace dgl {
+
+/**
+ * Static (non-incremental) path analysis of the currently enabled edges of a graph, used to preprocess graphs before
+ * search:
+ *  - markPathEdges() finds the edges that lie on at least one path from a source to any of a set of targets;
+ *  - EdgeDominators finds, for each node reachable from a source, the edges that lie on every path from the source to
+ *    that node.
+ * Both only follow edges in their direction in 'g' (so they can be applied to a DynamicBackGraph to analyze paths
+ * into the source).
+ */
+
+//Set on_path[id] for each enabled edge that lies on a path from 'source' to one of 'targets'.
+//on_path must have at least g.nEdgeIDs() elements; edges that are not on such a path are left unchanged.
+template<class Graph>
+void markPathEdges(Graph& g, int source, const std::vector<int>& targets, std::vector<bool>& on_path){
+    std::vector<bool> from_source(g.nodes(), false);
+    std::vector<bool> to_target(g.nodes(), false);
+    std::vector<int> q;
+    from_source[source] = true;
+    q.push_back(source);
+    for(int i = 0; i < q.size(); i++){
+        int u = q[i];
+        for(int j = 0; j < g.nIncident(u); j++){
+            int id = g.incident(u, j).id;
+            int v = g.incident(u, j).node;
+            if(g.edgeEnabled(id) && !from_source[v]){
+                from_source[v] = true;
+                q.push_back(v);
+            }
+        }
+    }
+    q.clear();
+    for(int t:targets){
+        if(!to_target[t]){
+            to_target[t] = true;
+            q.push_back(t);
+        }
+    }
+    for(int i = 0; i < q.size(); i++){
+        int u = q[i];
+        for(int j = 0; j < g.nIncoming(u); j++){
+            int id = g.incoming(u, j).id;
+            int v = g.incoming(u, j).node;
+            if(g.edgeEnabled(id) && !to_target[v]){
+                to_target[v] = true;
+                q.push_back(v);
+            }
+        }
+    }
+    for(int u = 0; u < g.nodes(); u++){
+        if(!from_source[u])
+            continue;
+        for(int j = 0; j < g.nIncident(u); j++){
+            int id = g.incident(u, j).id;
+            if(g.edgeEnabled(id) && to_target[g.incident(u, j).node]){
+                on_path[id] = true;
+            }
+        }
+    }
+}
+
+/**
+ * Computes the dominator tree of the graph in which every enabled edge is split by a node of its own, so that an edge
+ * dominates a node exactly if every path from the source to that node uses the edge.
+ * Uses the iterative algorithm of Cooper, Harvey and Kennedy ("A Simple, Fast Dominance Algorithm", 2001).
+ */
+template<class Graph>
+class EdgeDominators {
+    Graph& g;
+    int source;
+    int n_nodes = 0;
+    //indices 0..n_nodes-1 are graph nodes, n_nodes+id is the node splitting edge 'id'
+    std::vector<int> idom;
+    std::vector<int> post_order;
+    std::vector<int> rpo;//reachable nodes, in reverse post order
+    std::vector<int> edge_tail;
+
+    int intersect(int a, int b){
+        while(a != b){
+            while(post_order[a] < post_order[b])
+                a = idom[a];
+            while(post_order[b] < post_order[a])
+                b = idom[b];
+        }
+        return a;
+    }
+
+public:
+    EdgeDominators(Graph& graph, int source) : g(graph), source(source){
+    }
+
+    void run(){
+        n_nodes = g.nodes();
+        int n = n_nodes + g.nEdgeIDs();
+        idom.assign(n, -1);
+        post_order.assign(n, -1);
+        edge_tail.assign(g.nEdgeIDs(), -1);
+        rpo.clear();
+
+        //iterative depth first search from the source, recording the post order
+        std::vector<bool> visited(n, false);
+        std::vector<std::pair<int, int>> stack;//node, and the position of the next edge to explore
+        visited[source] = true;
+        stack.push_back({source, 0});
+        int next_post = 0;
+        while(!stack.empty()){
+            int u = stack.back().first;
+            int pos = stack.back().second;
+            if(u >= n_nodes){
+                //an edge node has one successor, the head of its edge
+                int head = stack.back().second;
+                if(head >= 0){
+                    stack.back().second = -1;
+                    if(!visited[head]){
+                        visited[head] = true;
+                        stack.push_back({head, 0});
+                    }
+                    continue;
+                }
+            }else if(pos < g.nIncident(u)){
+                stack.back().second++;
+                int id = g.incident(u, pos).id;
+                if(g.edgeEnabled(id) && !visited[n_nodes + id]){
+                    visited[n_nodes + id] = true;
+                    edge_tail[id] = u;
+                    stack.push_back({n_nodes + id, g.incident(u, pos).node});
+                }
+                continue;
+            }
+            post_order[u] = next_post++;
+            rpo.push_back(u);
+            stack.pop_back();
+        }
+        std::reverse(rpo.begin(), rpo.end());
+
+        idom[source] = source;
+        bool changed = true;
+        while(changed){
+            changed = false;
+            for(int u:rpo){
+                if(u == source)
+                    continue;
+                int new_idom = -1;
+                if(u >= n_nodes){
+                    //the only predecessor of an edge node is the tail of its edge
+                    new_idom = edge_tail[u - n_nodes];
+                }else{
+                    for(int j = 0; j < g.nIncoming(u); j++){
+                        int p = n_nodes + g.incoming(u, j).id;
+                        if(idom[p] < 0)
+                            continue;//not reachable from the source, or not yet processed
+                        new_idom = new_idom < 0 ? p : intersect(p, new_idom);
+                    }
+                }
+                if(new_idom >= 0 && idom[u] != new_idom){
+                    idom[u] = new_idom;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    bool reachable(int node) const{
+        return idom[node] >= 0;
+    }
+
+    //Store the ids of the edges that are on every path from the source to 'node' (which must be reachable),
+    //nearest to 'node' first.
+    void getDominatingEdges(int node, std::vector<int>& store){
+        store.clear();
+        assert(reachable(node));
+        int n = node;
+        while(n != source){
+            n = idom[n];
+            if(n >= n_nodes)
+                store.push_back(n - n_nodes);
+        }
+    }
+};
+};
+#endif
@@ -30,6 +30,7 @@
 #include <monosat/dgl/Reach.h>
 //#include "monosat/core/Config.h"
 //#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdio>
 #include <limits>
@@ -46,7 +47,8 @@ namespace dgl {
 template<typename Weight = int, typename Graph = DynamicGraph<Weight>, class Status = typename Distance<Weight>::NullStatus>
 class RamalRepsBatched : public Distance<Weight>, public DynamicGraphAlgorithm {
 public:
-    static bool ever_warned_about_zero_weights;
+    //atomic, as detectors using this class may be updated concurrently
+    static std::atomic<bool> ever_warned_about_zero_weights;
     Graph& g;
     std::vector<Weight>& weights;
     std::vector<Weight> local_weights;
@@ -310,8 +312,6 @@ public:
 
     //Called when an edge is enabled
     void AddEdge(int edgeID){
-        static int iter = 0;
-        ++iter;
 
         assert(g.edgeEnabled(edgeID));
         if(edgeInShortestPathGraph[edgeID])
@@ -384,8 +384,6 @@ public:
 
     //Called if an edge weight is decreased
     void DecreaseWeight(int edgeID){
-        static int iter = 0;
-        ++iter;
 
         assert(g.edgeEnabled(edgeID));
         //if (edgeInShortestPathGraph[edgeID]) //must process this whether or not the edge is in the shortest path
@@ -524,11 +522,6 @@ public:
             //fprintf(g.outfile(), "r %d\n", getSource());
         }
 
-        static int iteration = 0;
-        int local_it = ++iteration;
-        if(local_it == 5){
-            int a = 1;
-        }
         stats_all_updates++;
         if(last_modification > 0 && g.getCurrentHistory() == last_modification)
             return;
@@ -584,8 +577,7 @@ public:
         edgeInShortestPathGraph.resize(g.nEdgeIDs());
 
         if(has_zero_weights){
-            if(!ever_warned_about_zero_weights){
-                ever_warned_about_zero_weights = true;
+            if(!ever_warned_about_zero_weights.exchange(true)){
                 fprintf(stderr,
                         "Warning: Ramalingham-Reps doesn't support zero-weight edges; falling back on Dijkstra's (which is much slower)\n");
             }
@@ -607,8 +599,7 @@ public:
                                 local_weights[edgeid] = weights[edgeid];
                                 if(weights[edgeid] == 0){
                                     assert(!has_zero_weights);
-                                    if(!ever_warned_about_zero_weights){
-                                        ever_warned_about_zero_weights = true;
+                                    if(!ever_warned_about_zero_weights.exchange(true)){
                                         fprintf(stderr,
                                                 "Warning: Ramalingham-Reps doesn't support zero-weight edges; falling back on Dijkstra's (which is much slower)\n");
                                     }
@@ -638,8 +629,7 @@ public:
                         local_weights[edgeid] = weights[edgeid];
                         if(weights[edgeid] == 0){
                             assert(!has_zero_weights);
-                            if(!ever_warned_about_zero_weights){
-                                ever_warned_about_zero_weights = true;
+                            if(!ever_warned_about_zero_weights.exchange(true)){
                                 fprintf(stderr,
                                         "Warning: Ramalingham-Reps doesn't support zero-weight edges; falling back on Dijkstra's (which is much slower)\n");
                             }
@@ -1508,8 +1498,6 @@ public:
     }
 
     void AddEdge(int edgeID){
-        static int iter = 0;
-        ++iter;
         dbg_delta_lite();
         assert(g.edgeEnabled(edgeID));
         if(edgeInShortestPathGraph[edgeID])
@@ -2467,6 +2455,6 @@ public:
 };
 
 template<typename Weight, typename Graph, class Status>
-bool RamalRepsBatched<Weight, Graph, Status>::ever_warned_about_zero_weights = false;
+std::atomic<bool> RamalRepsBatched<Weight, Graph, Status>::ever_warned_about_zero_weights(false);
 };
 #endif
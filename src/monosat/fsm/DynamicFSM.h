@@ -35,6 +35,7 @@ class DynamicFSM {
     int n_total_output_emoves = 0;
     int n_enabled_input_emoves = 0;
     int n_enabled_output_emoves = 0;
+    int n_transitions_defined = 0;
 public:
     vec<Bitset> transitions;
 
@@ -186,6 +187,7 @@ public:
         }
         transitions.growTo(edgeID + 1);
         transitions[edgeID].growTo(inAlphabet() * outAlphabet());
+        n_transitions_defined++;
         int pos = input + output * inAlphabet();
         if(defaultEnabled){
             transitions[edgeID].set(pos);
@@ -238,6 +240,11 @@ public:
         }
     }
 
+    //Number of calls to addTransition(); transitions that are defined this way are not recorded in the history.
+    int transitionsDefined() const{
+        return n_transitions_defined;
+    }
+
     int addState(){
         return addNode();
     }
@@ -35,9 +35,11 @@ FSMAcceptDetector::FSMAcceptDetector(int detectorID, FSMTheorySolver* outer, Dyn
     overReachStatus = new FSMAcceptDetector::AcceptStatus(*this, false);
     if(!opt_fsm_as_graph){
         underapprox_detector = new NFAAccept<FSMAcceptDetector::AcceptStatus>(g_under, source, str, *underReachStatus,
-                                                                              opt_fsm_track_used_transitions);
+                                                                              opt_fsm_track_used_transitions,
+                                                                              opt_fsm_bitparallel);
         overapprox_detector = new NFAAccept<FSMAcceptDetector::AcceptStatus>(g_over, source, str, *overReachStatus,
-                                                                             opt_fsm_track_used_transitions);
+                                                                             opt_fsm_track_used_transitions,
+                                                                             opt_fsm_bitparallel);
     }else{
         underapprox_detector = new NFAGraphAccept<FSMAcceptDetector::AcceptStatus>(g_under, source, str,
                                                                                    *underReachStatus,
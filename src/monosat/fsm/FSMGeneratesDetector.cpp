@@ -33,8 +33,10 @@ FSMGeneratesDetector::FSMGeneratesDetector(int detectorID, FSMTheorySolver* oute
     overReachStatus = new FSMGeneratesDetector::GenerateStatus(*this, false);
 
     underapprox_detector = new NFAGenerate<FSMGeneratesDetector::GenerateStatus>(g_under, source, str,
-                                                                                 *underReachStatus);
-    overapprox_detector = new NFAGenerate<FSMGeneratesDetector::GenerateStatus>(g_over, source, str, *overReachStatus);
+                                                                                 *underReachStatus,
+                                                                                 opt_fsm_bitparallel);
+    overapprox_detector = new NFAGenerate<FSMGeneratesDetector::GenerateStatus>(g_over, source, str, *overReachStatus,
+                                                                                opt_fsm_bitparallel);
 
     underprop_marker = outer->newReasonMarker(getID());
     overprop_marker = outer->newReasonMarker(getID());
@@ -625,6 +625,15 @@ public:
 
     };
 
+    bool supportsChronologicalBacktracking() override{
+        return true;
+    }
+
+    bool supportsSkippingBacktrack() override{
+        //all of this theory's levels are created by enqueueTheory() or propagateTheory()
+        return true;
+    }
+
     bool supportsDecisions() override{
         return true;
     }
@@ -786,6 +795,12 @@ public:
         unimplemented_generate_string_constraints.clear();
     }
 
+    bool hasPendingConstraints() override{
+        return unimplemented_string_accept_constraints.size() > 0 ||
+               unimplemented_generator_accept_constraints.size() > 0 ||
+               unimplemented_transduce_constraints.size() > 0 || unimplemented_generate_string_constraints.size() > 0;
+    }
+
     void preprocess() override{
         implementConstraints();
         for(int i = 0; i < detectors.size(); i++){
@@ -815,8 +830,6 @@ public:
 
         int lev = level(v);
 
-        assert(decisionLevel() <= lev);
-
         while(lev > trail_lim.size()){
             newDecisionLevel();
         }
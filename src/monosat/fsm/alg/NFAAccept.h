@@ -11,9 +11,11 @@
 #include "monosat/dgl/DynamicGraph.h"
 #include "monosat/fsm/alg/NFATypes.h"
 #include "monosat/fsm/alg/NFAAcceptor.h"
+#include "monosat/fsm/alg/NFABitSimulator.h"
+#include "monosat/fsm/alg/NFAStringTrie.h"
 #include "monosat/fsm/DynamicFSM.h"
 #include "monosat/mtl/Vec.h"
-//#include "monosat/mtl/Bitset.h"
+#include "monosat/mtl/Bitset.h"
 #include <cassert>
 #include <vector>
 
@@ -66,10 +68,20 @@ class NFAAccept : public NFAAcceptor {
 
     int n_track_positive = 0;
     int n_track_negative = 0;
+
+    //if bitParallel is set, state sets are simulated word-parallel by 'simulator' instead of by scanning transitions,
+    //and memoized in a trie over the strings, so that strings with common prefixes share their simulation
+    bool bitParallel = false;
+    NFABitSimulator simulator;
+    NFAStringTrie trie;
 public:
     NFAAccept(DynamicFSM& f, int source, vec<vec<int>>& strings, Status& status = fsmNullStatus,
-              bool trackUsedTransitions = false) : g(f), status(status), source(source), strings(strings),
-                                                   checkUsed(trackUsedTransitions){
+              bool trackUsedTransitions = false, bool bitParallel = false) : g(f), status(status), source(source),
+                                                                             strings(strings),
+                                                                             checkUsed(trackUsedTransitions),
+                                                                             bitParallel(bitParallel),
+                                                                             simulator(f, false),
+                                                                             trie(simulator, source){
 
         buildStringTrackers();
     }
@@ -145,8 +157,32 @@ private:
         return num_updates;
     }
 
-    void find_accepts(int str){
+    //Bit-parallel version of find_accepts.
+    //Individual transitions are not tracked, so all transitions are conservatively treated as used.
+    void find_accepts_bitparallel(int str){
+        for(int s:accepts){
+            cur_seen[s] = false;
+        }
+        accepts.clear();
+        hasUsed = false;
+        trie.addStrings(strings);
+        const Bitset& sim_states = trie.states(str);
+        for(int w = 0; w < sim_states.nWords(); w++){
+            uint64_t word = sim_states.getWord(w);
+            while(word){
+                int s = w * BITSET_ELEMENT_SIZE + __builtin_ctzll(word);
+                word &= word - 1;
+                cur_seen[s] = true;
+                accepts.push(s);
+            }
+        }
+    }
 
+    void find_accepts(int str){
+        if(bitParallel){
+            find_accepts_bitparallel(str);
+            return;
+        }
         for(int s:accepts){
             assert(cur_seen);
             cur_seen[s] = false;
@@ -0,0 +1,271 @@
+/*
+ * NFABitSimulator.h
+ *
+ *  Bit-parallel simulation of the set of states an NFA can be in.
+ */
+
+#ifndef NFA_BITSIMULATOR_H_
+#define NFA_BITSIMULATOR_H_
+
+#include "monosat/fsm/DynamicFSM.h"
+#include "monosat/mtl/Bitset.h"
+#include "monosat/mtl/Vec.h"
+#include <cassert>
+#include <algorithm>
+
+using namespace Monosat;
+
+/**
+ * Simulates an NFA on a string using word-packed state sets.
+ * For each symbol, each state has a precomputed successor mask (the set of states reachable from that state
+ * by a single enabled transition on that symbol); advancing the state set by one character is then the union
+ * of the successor masks of the current states.
+ * The successor masks are kept in sync with the FSM incrementally, by replaying its transition history.
+ *
+ * If 'outputLabels' is false, the simulation reads input symbols (transitions with output 0), as for acceptance;
+ * otherwise it reads output symbols (transitions with input 0), as for generation. Symbol 0 is the empty move.
+ */
+class NFABitSimulator {
+    DynamicFSM& g;
+    bool outputLabels;
+
+    //successors[label][state] is the set of states reachable from state by one enabled transition with this label.
+    vec<vec<Bitset>> successors;
+    //set of states with at least one enabled transition on this label, used to skip empty masks
+    vec<Bitset> has_successors;
+
+    int n_states = -1;
+    int n_edges = -1;
+    int n_labels = -1;
+    int n_transitions_defined = -1;
+    int64_t last_history_clear = -1;
+    int history_qhead = 0;
+
+    //changed_from[label] is the set of states with a transition on this label that changed since the last clearChanges()
+    vec<Bitset> changed_from;
+    bool any_changes = false;
+
+    Bitset tmp;
+    vec<int> to_visit;
+
+public:
+    int64_t stats_rebuilds = 0;
+    int64_t stats_incremental_updates = 0;
+    int64_t stats_steps = 0;
+
+    NFABitSimulator(DynamicFSM& g, bool outputLabels = false) : g(g), outputLabels(outputLabels){
+
+    }
+
+    int nLabels() const{
+        return n_labels;
+    }
+
+    //Bring the successor masks up to date with the FSM.
+    void sync(){
+        int labels = outputLabels ? g.outAlphabet() : g.inAlphabet();
+        if(n_states != g.states() || n_edges != g.nEdgeIDs() || n_labels != labels ||
+           n_transitions_defined != g.transitionsDefined() || last_history_clear != g.historyclears){
+            rebuild();
+            return;
+        }
+        for(int i = history_qhead; i < g.history.size(); i++){
+            DynamicFSM::EdgeChange& c = g.history[i];
+            int label = outputLabels ? c.output : c.input;
+            int other = outputLabels ? c.input : c.output;
+            if(other != 0)
+                continue;
+            stats_incremental_updates++;
+            DynamicGraph<bool>::FullEdge e = g.getEdge(c.id);
+            if(refresh(e.from, e.to, label)){
+                changed_from[label].set(e.from);
+                any_changes = true;
+            }
+        }
+        history_qhead = g.history.size();
+    }
+
+    //Number of times the successor masks have been rebuilt from scratch; any state sets computed before the
+    //last rebuild must be discarded, as they may have a different number of states.
+    int64_t nRebuilds() const{
+        return stats_rebuilds;
+    }
+
+    //True if any successor mask has changed since the last call to clearChanges().
+    bool hasChanges() const{
+        return any_changes;
+    }
+
+    //True if a transition on 'label' leaving any of 'states' has changed since the last call to clearChanges().
+    bool changedFrom(int label, const Bitset& states) const{
+        if(!any_changes || label >= n_labels)
+            return false;
+        const Bitset& changed = changed_from[label];
+        int words = std::min(states.nWords(), changed.nWords());
+        for(int w = 0; w < words; w++){
+            if(states.getWord(w) & changed.getWord(w))
+                return true;
+        }
+        return false;
+    }
+
+    void clearChanges(){
+        if(any_changes){
+            for(Bitset& b:changed_from){
+                b.zero();
+            }
+            any_changes = false;
+        }
+    }
+
+    //Compute the set of states reachable from 'source' after reading 'string'
+    //(including empty moves before, between, and after each character).
+    void run(int source, const vec<int>& string, Bitset& states){
+        sync();
+        states.clear();
+        states.growTo(n_states);
+        states.zero();
+        states.set(source);
+        emoveClosure(states);
+        for(int l:string){
+            if(!step(states, l, states))
+                break;
+        }
+    }
+
+    //Advance the state set 'from' by one character 'label', followed by empty moves.
+    //Returns false if the resulting set is empty. 'from' and 'to' may be the same bitset.
+    bool step(const Bitset& from, int label, Bitset& to){
+        assert(label > 0);
+        stats_steps++;
+        tmp.clear();
+        tmp.growTo(n_states);
+        tmp.zero();
+        bool any = false;
+        if(label < n_labels){
+            vec<Bitset>& succ = successors[label];
+            const Bitset& active = has_successors[label];
+            int words = std::min(from.nWords(), active.nWords());
+            for(int w = 0; w < words; w++){
+                uint64_t word = from.getWord(w) & active.getWord(w);
+                while(word){
+                    int s = w * BITSET_ELEMENT_SIZE + __builtin_ctzll(word);
+                    word &= word - 1;
+                    tmp.Or(succ[s]);
+                    any = true;
+                }
+            }
+        }
+        if(any){
+            emoveClosure(tmp);
+            any = tmp.any();
+        }
+        to.copyFrom(tmp);
+        return any;
+    }
+
+    //Extend 'states' with all states reachable from it by enabled empty moves.
+    void emoveClosure(Bitset& states){
+        if(n_labels <= 0 || !has_successors[0].any())
+            return;
+        vec<Bitset>& succ = successors[0];
+        const Bitset& active = has_successors[0];
+        to_visit.clear();
+        int words = std::min(states.nWords(), active.nWords());
+        for(int w = 0; w < words; w++){
+            uint64_t word = states.getWord(w) & active.getWord(w);
+            while(word){
+                to_visit.push(w * BITSET_ELEMENT_SIZE + __builtin_ctzll(word));
+                word &= word - 1;
+            }
+        }
+        while(to_visit.size()){
+            int s = to_visit.last();
+            to_visit.pop();
+            const Bitset& next = succ[s];
+            for(int w = 0; w < next.nWords(); w++){
+                uint64_t word = next.getWord(w) & ~states.getWord(w);
+                while(word){
+                    int t = w * BITSET_ELEMENT_SIZE + __builtin_ctzll(word);
+                    word &= word - 1;
+                    states.set(t);
+                    if(active[t])
+                        to_visit.push(t);
+                }
+            }
+        }
+    }
+
+private:
+
+    bool transitionEnabled(int edgeID, int label){
+        return outputLabels ? g.transitionEnabled(edgeID, 0, label) : g.transitionEnabled(edgeID, label, 0);
+    }
+
+    //Recompute whether 'to' is a successor of 'from' on 'label' (there may be several parallel transitions).
+    //Returns true if the successor mask changed.
+    bool refresh(int from, int to, int label){
+        bool enabled = false;
+        for(int j = 0; j < g.nIncident(from); j++){
+            if(g.incident(from, j).node == to && transitionEnabled(g.incident(from, j).id, label)){
+                enabled = true;
+                break;
+            }
+        }
+        Bitset& succ = successors[label][from];
+        if(enabled == succ[to])
+            return false;
+        if(enabled){
+            succ.set(to);
+            has_successors[label].set(from);
+        }else{
+            succ.clear(to);
+            if(!succ.any())
+                has_successors[label].clear(from);
+        }
+        return true;
+    }
+
+    void rebuild(){
+        stats_rebuilds++;
+        n_states = g.states();
+        n_edges = g.nEdgeIDs();
+        n_labels = outputLabels ? g.outAlphabet() : g.inAlphabet();
+        n_transitions_defined = g.transitionsDefined();
+        last_history_clear = g.historyclears;
+        history_qhead = g.history.size();
+
+        successors.growTo(n_labels);
+        has_successors.growTo(n_labels);
+        changed_from.growTo(n_labels);
+        any_changes = false;
+        for(int l = 0; l < n_labels; l++){
+            successors[l].growTo(n_states);
+            for(int s = 0; s < n_states; s++){
+                successors[l][s].clear();
+                successors[l][s].growTo(n_states);
+                successors[l][s].zero();
+            }
+            has_successors[l].clear();
+            has_successors[l].growTo(n_states);
+            has_successors[l].zero();
+            changed_from[l].clear();
+            changed_from[l].growTo(n_states);
+            changed_from[l].zero();
+        }
+        for(int s = 0; s < n_states; s++){
+            for(int j = 0; j < g.nIncident(s); j++){
+                int edgeID = g.incident(s, j).id;
+                int to = g.incident(s, j).node;
+                for(int l = 0; l < n_labels; l++){
+                    if(transitionEnabled(edgeID, l)){
+                        successors[l][s].set(to);
+                        has_successors[l].set(s);
+                    }
+                }
+            }
+        }
+    }
+};
+
+#endif /* NFA_BITSIMULATOR_H_ */
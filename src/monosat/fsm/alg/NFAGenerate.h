@@ -12,6 +12,7 @@
 #include "monosat/mtl/Bitset.h"
 #include "monosat/mtl/Vec.h"
 #include "monosat/fsm/alg/NFATypes.h"
+#include "monosat/fsm/alg/NFABitSimulator.h"
 
 using namespace Monosat;
 
@@ -47,12 +48,17 @@ class NFAGenerate {
     int source;
     vec<vec<int>>& strings;
 
-
+    //if bitParallel is set, strings that cannot be generated even non-deterministically are
+    //rejected by a word-parallel simulation, before searching for a deterministic path.
+    bool bitParallel = false;
+    NFABitSimulator simulator;
+    Bitset sim_states;
 public:
-    NFAGenerate(DynamicFSM& f, int source, vec<vec<int>>& strings, Status& status = fsmNullStatus) : g(f),
-                                                                                                     status(status),
-                                                                                                     source(source),
-                                                                                                     strings(strings){
+    int64_t stats_bitparallel_rejections = 0;
+
+    NFAGenerate(DynamicFSM& f, int source, vec<vec<int>>& strings, Status& status = fsmNullStatus,
+                bool bitParallel = false) : g(f), status(status), source(source), strings(strings),
+                                            bitParallel(bitParallel), simulator(f, true){
 
     }
 
@@ -197,6 +203,13 @@ public:
 
     //inefficient!
     bool generatesString(int string){
+        if(bitParallel){
+            simulator.run(source, strings[string], sim_states);
+            if(!sim_states.any()){
+                stats_bitparallel_rejections++;
+                return false;
+            }
+        }
         static vec<NFATransition> ignore;
         ignore.clear();
         return getPath(string, ignore);
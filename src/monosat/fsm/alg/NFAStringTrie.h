@@ -0,0 +1,181 @@
+/*
+ * NFAStringTrie.h
+ *
+ *  Shared-prefix evaluation of many strings against an NFA.
+ */
+
+#ifndef NFA_STRINGTRIE_H_
+#define NFA_STRINGTRIE_H_
+
+#include "monosat/fsm/alg/NFABitSimulator.h"
+#include "monosat/mtl/Bitset.h"
+#include "monosat/mtl/Vec.h"
+#include <cassert>
+
+using namespace Monosat;
+
+/**
+ * A trie of strings, in which each node memoizes the set of NFA states reachable after reading the prefix
+ * that leads to that node. Strings that share a prefix share the simulation of that prefix.
+ *
+ * When transitions of the NFA change, only the nodes whose state sets could be affected are invalidated
+ * (along with their subtrees): a node is invalidated if a changed transition on the node's symbol leaves a
+ * state of its parent's set, or if a changed empty move leaves a state of its own set.
+ */
+class NFAStringTrie {
+    NFABitSimulator& sim;
+    int source;
+
+    struct Node {
+        int parent = -1;
+        int label = 0;
+        bool valid = false;
+        vec<int> children;//child node ids, one per distinct next symbol
+    };
+    vec<Node> nodes;
+    vec<Bitset> node_states;
+    vec<int> string_nodes;//for each string, the node it ends at
+    vec<int> to_visit;
+    vec<int> to_invalidate;
+    vec<int> empty_string;
+    int64_t last_rebuild = -1;
+
+public:
+    int64_t stats_steps = 0;
+    int64_t stats_cached = 0;
+    int64_t stats_invalidated = 0;
+
+    NFAStringTrie(NFABitSimulator& sim, int source) : sim(sim), source(source){
+        nodes.push();//root
+        node_states.push();
+    }
+
+    int nNodes() const{
+        return nodes.size();
+    }
+
+    //Add strings until all of 'strings' are in the trie.
+    void addStrings(const vec<vec<int>>& strings){
+        for(int i = string_nodes.size(); i < strings.size(); i++){
+            string_nodes.push(insert(strings[i]));
+        }
+    }
+
+    //Return the set of states reachable after reading the string with this id.
+    const Bitset& states(int str){
+        sync();
+        int n = string_nodes[str];
+        if(nodes[n].valid){
+            stats_cached++;
+            return node_states[n];
+        }
+        //walk up to the deepest valid ancestor, then simulate down from it
+        to_visit.clear();
+        while(n >= 0 && !nodes[n].valid){
+            to_visit.push(n);
+            n = nodes[n].parent;
+        }
+        while(to_visit.size()){
+            int c = to_visit.last();
+            to_visit.pop();
+            compute(c);
+        }
+        return node_states[string_nodes[str]];
+    }
+
+private:
+
+    int insert(const vec<int>& string){
+        int n = 0;
+        for(int l:string){
+            int child = -1;
+            for(int c:nodes[n].children){
+                if(nodes[c].label == l){
+                    child = c;
+                    break;
+                }
+            }
+            if(child < 0){
+                child = nodes.size();
+                nodes.push();
+                node_states.push();
+                nodes[child].parent = n;
+                nodes[child].label = l;
+                nodes[n].children.push(child);
+            }
+            n = child;
+        }
+        return n;
+    }
+
+    void compute(int n){
+        Node& node = nodes[n];
+        assert(!node.valid);
+        if(node.parent < 0){
+            //root
+            sim.run(source, empty_string, node_states[n]);
+        }else{
+            assert(nodes[node.parent].valid);
+            stats_steps++;
+            sim.step(node_states[node.parent], node.label, node_states[n]);
+        }
+        node.valid = true;
+    }
+
+    //Bring the simulator up to date, and invalidate any nodes affected by changed transitions.
+    void sync(){
+        sim.sync();
+        if(sim.nRebuilds() != last_rebuild){
+            //the simulator was rebuilt from scratch; nothing can be reused
+            last_rebuild = sim.nRebuilds();
+            for(Node& node:nodes){
+                node.valid = false;
+            }
+            sim.clearChanges();
+            return;
+        }
+        if(!sim.hasChanges())
+            return;
+        //visit all valid nodes top-down; a valid node's parent is always valid.
+        to_visit.clear();
+        if(nodes[0].valid)
+            to_visit.push(0);
+        while(to_visit.size()){
+            int n = to_visit.last();
+            to_visit.pop();
+            Node& node = nodes[n];
+            assert(node.valid);
+            bool affected = sim.changedFrom(0, node_states[n]);
+            if(!affected && node.parent >= 0){
+                affected = sim.changedFrom(node.label, node_states[node.parent]);
+            }
+            if(affected){
+                invalidate(n);
+            }else{
+                for(int c:node.children){
+                    if(nodes[c].valid)
+                        to_visit.push(c);
+                }
+            }
+        }
+        sim.clearChanges();
+    }
+
+    void invalidate(int n){
+        to_invalidate.clear();
+        to_invalidate.push(n);
+        while(to_invalidate.size()){
+            int m = to_invalidate.last();
+            to_invalidate.pop();
+            if(!nodes[m].valid)
+                continue;
+            nodes[m].valid = false;
+            stats_invalidated++;
+            for(int c:nodes[m].children){
+                to_invalidate.push(c);
+            }
+        }
+    }
+};
+
+#endif /* NFA_STRINGTRIE_H_ */
@@ -30,6 +30,7 @@
 #include <string>
 #include <cstdio>
 #include <iostream>
+#include <vector>
 
 namespace Monosat {
 
@@ -104,6 +105,14 @@ public:
 
     virtual bool propagate(vec<Lit>& conflict)=0;
 
+    //Bring this detector's under/over approximations up to date with the current graphs, without assigning any literals
+    //(propagate() will then find them already up to date). This may be called concurrently for different detectors,
+    //so implementations must only read the shared graphs and the solver's assignment, and must only write to state
+    //owned by this detector (including its dgl algorithms, which therefore must not use static mutable state).
+    virtual void updateApproximations(){
+
+    }
+
     virtual bool propagate(vec<Lit>& conflict, bool backtrackOnly, Lit& conflictLit){
         return propagate(conflict);
     }
@@ -120,6 +129,27 @@ public:
 
     }
 
+    //Graph preprocessing (see GraphTheorySolver::preprocessGraph), called at level 0.
+    //Set relevant[edgeID] for every edge that this detector's atoms may depend on in the current over-approximate graph,
+    //and return true; or return false if this detector may depend on every edge of the graph.
+    virtual bool markRelevantEdges(std::vector<bool>& relevant){
+        return false;
+    }
+
+    //Graph preprocessing, called at level 0: for each atom of this detector whose truth requires a path from the
+    //source through some edge (in every path of the current over-approximate graph), push the atom to 'atoms' and
+    //that edge to 'edges'.
+    virtual void findForcedEdges(vec<Lit>& atoms, vec<int>& edges){
+
+    }
+
+    //Graph preprocessing, called at level 0: set endpoints[node] for every node that this detector's atoms refer to,
+    //and return true if they only depend on which of those nodes are connected by paths, and on the total weights of
+    //those paths (so that chains of edges through other nodes can be contracted); otherwise, return false.
+    virtual bool markPathEndpoints(std::vector<bool>& endpoints){
+        return false;
+    }
+
     virtual void backtrack(int level){
         //do nothing
     }
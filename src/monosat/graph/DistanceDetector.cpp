@@ -29,6 +29,7 @@
 #include "monosat/dgl/KohliTorr.h"
 #include "monosat/dgl/EdmondsKarpDynamic.h"
 #include "monosat/dgl/Dinics.h"
+#include "monosat/dgl/EdgeDominators.h"
 #include "monosat/dgl/DinicsLinkCut.h"
 #include "monosat/graph/DistanceDetector.h"
 #include "monosat/graph/GraphTheory.h"
@@ -845,6 +846,54 @@ void DistanceDetector<Weight, Graph>::preprocess(){
 }
 
 
+template<typename Weight, typename Graph>
+bool DistanceDetector<Weight, Graph>::markRelevantEdges(std::vector<bool>& relevant){
+    std::vector<int> targets;
+    for(int node = 0; node < unweighted_dist_lits.size(); node++){
+        if(unweighted_dist_lits[node].size())
+            targets.push_back(node);
+    }
+    markPathEdges(g_over, source, targets, relevant);
+    return true;
+}
+
+template<typename Weight, typename Graph>
+void DistanceDetector<Weight, Graph>::findForcedEdges(vec<Lit>& atoms, vec<int>& edges){
+    EdgeDominators<Graph> dominators(g_over, source);
+    dominators.run();
+    std::vector<int> path_edges;
+    for(int node = 0; node < unweighted_dist_lits.size(); node++){
+        if(!unweighted_dist_lits[node].size() || !dominators.reachable(node))
+            continue;
+        dominators.getDominatingEdges(node, path_edges);
+        //each distance atom of this node that is true requires a path to it
+        for(UnweightedDistLit& d:unweighted_dist_lits[node]){
+            if(outer->value(d.l) == l_False)
+                continue;
+            for(int edgeID:path_edges){
+                atoms.push(d.l);
+                edges.push(edgeID);
+            }
+        }
+    }
+}
+
+template<typename Weight, typename Graph>
+void DistanceDetector<Weight, Graph>::updateApproximations(){
+    if(!underapprox_unweighted_distance_detector)
+        return;
+    if(!opt_detect_pure_theory_lits || unassigned_positives > 0){
+        double startdreachtime = rtime(2);
+        underapprox_unweighted_distance_detector->update();
+        stats_under_update_time += rtime(2) - startdreachtime;
+    }
+    if(!opt_detect_pure_theory_lits || unassigned_negatives > 0){
+        double startunreachtime = rtime(2);
+        overapprox_unweighted_distance_detector->update();
+        stats_over_update_time += rtime(2) - startunreachtime;
+    }
+}
+
 template<typename Weight, typename Graph>
 bool DistanceDetector<Weight, Graph>::propagate(vec<Lit>& conflict){
     if(!underapprox_unweighted_distance_detector)
@@ -258,8 +258,14 @@ public:
 
     void preprocess() override;
 
+    bool markRelevantEdges(std::vector<bool>& relevant) override;
+
+    void findForcedEdges(vec <Lit>& atoms, vec<int>& edges) override;
+
     bool propagate(vec <Lit>& conflict) override;
 
+    void updateApproximations() override;
+
     void buildUnweightedDistanceLEQReason(int node, vec <Lit>& conflict);
 
     void buildUnweightedDistanceGTReason(int node, int within_steps, vec <Lit>& conflict);
@@ -1364,13 +1364,14 @@ public:
             //enforce that _exactly_ one edge from this edge set is assigned in the SAT solver
 
             S.addClause(edgeset);
-            AMOTheory* amo = new AMOTheory(&S);
+            vec<Lit> amo_lits;
             for(Lit l: edgeset){
                 Var v = S.newVar();
                 S.addClause(mkLit(v), ~l);//introduce a fresh lit, force it to be equal to the old one
                 S.addClause(~mkLit(v), l);
-                amo->addVar(v);
+                amo_lits.push(mkLit(v));
             }
+            AMOTheory::getAMOTheory(&S)->addGroup(amo_lits);
 
 
         }
@@ -45,6 +45,7 @@
 #include "monosat/graph/WeightedDijkstra.h"
 #include "monosat/graph/GraphTheoryTypes.h"
 #include "monosat/utils/System.h"
+#include "monosat/utils/ThreadPool.h"
 #include "monosat/core/Solver.h"
 
 #include "monosat/graph/AllPairsDetector.h"
@@ -91,6 +92,26 @@ private:
 	 * This is to ensure we don't get inconsistent results if edges are added after clauses are learnt in the graph theory.
 	 */
     bool frozen = false;
+    /**
+	 * Graph preprocessing state (see preprocessGraph()): edges that are left out of the graphs used by the detectors,
+	 * the number of theory vars when the graph was last preprocessed, and the atoms already analyzed for forced edges.
+	 */
+    std::vector<bool> dead_edges;
+    int preprocessed_vars = 0;
+    vec<bool> forced_edges_analyzed;
+    /**
+	 * Chains of edges that have been replaced by a single edge (see contractChains()). While a chain is contracted,
+	 * its edges are left out of the graphs; once expanded, the edge that replaced it is left out instead.
+	 */
+    struct ContractedChain {
+        int edgeID;
+        std::vector<int> edges;
+        bool contracted;
+    };
+    std::vector<ContractedChain> chains;
+    std::vector<bool> contracted_edges;
+    std::vector<int> chain_of_edge;//for each edge that replaces a chain, the index of that chain
+    bool chains_searched = false;
 public:
     int n_satisfied_detectors = 0;
     bool all_edges_unit = true;
@@ -585,6 +606,43 @@ public:
     CycleDetector<Weight>* cycle_detector = nullptr;
     vec<SteinerDetector<Weight>*> steiner_detectors;
 
+    //Worker threads for updating detectors in parallel during propagation (only created if opt_graph_prop_threads>1)
+    ThreadPool* detector_pool = nullptr;
+
+    //Version of the graphs that a detector reads, used to detect whether its inputs have changed.
+    struct GraphVersion {
+        int under_history = -1;
+        int over_history = -1;
+        int under_weights_over_history = -1;
+        int over_weights_under_history = -1;
+        int64_t under_clears = -1;
+        int64_t over_clears = -1;
+
+        bool operator==(const GraphVersion& other) const{
+            return under_history == other.under_history && over_history == other.over_history &&
+                   under_weights_over_history == other.under_weights_over_history &&
+                   over_weights_under_history == other.over_weights_under_history &&
+                   under_clears == other.under_clears && over_clears == other.over_clears;
+        }
+    };
+
+    //Per-detector scheduling state (see scheduleDetectors)
+    struct DetectorSchedule {
+        double activity = 0;
+        //incremented whenever one of the detector's atoms or bitvectors is assigned or unassigned
+        int64_t input_changes = 0;
+        //state of the detector's inputs the last time it was propagated without conflict
+        int clean_level = -1;//-1 if the detector has to be propagated
+        int64_t clean_input_changes = -1;
+        GraphVersion clean_graphs;
+    };
+    vec<DetectorSchedule> detector_schedule;
+    vec<int> detector_order;//detector IDs, in descending order of activity
+    vec<int> detector_order_pos;
+    vec<int> detectors_to_propagate;
+    double detector_activity_inc = 1;
+    int max_clean_level = -1;
+
     struct MarkerEntry {
         int id = -1;
         bool forTheory = false;
@@ -690,6 +748,11 @@ public:
     int64_t stats_bv_enqueue_while_sat = 0;
     int64_t stats_backtrack_assigns = 0;
     int64_t stats_enqueues = 0;
+    int64_t stats_dead_edges = 0;
+    int64_t stats_contracted_chains = 0;
+    int64_t stats_contracted_edges = 0;
+    int64_t stats_forced_edges = 0;
+    double stats_graph_preprocess_time = 0;
     double reachupdatetime = 0;
     double unreachupdatetime = 0;
     double stats_initial_propagation_time = 0;
@@ -703,6 +766,11 @@ public:
     int64_t stats_pure_skipped = 0;
     int64_t stats_mc_calls = 0;
     int64_t stats_propagations_skipped = 0;
+    int64_t stats_parallel_updates = 0;
+    int64_t stats_detector_propagations = 0;
+    int64_t stats_detectors_skipped_unchanged = 0;
+    int64_t stats_detector_visits_before_conflict = 0;
+    double stats_parallel_update_time = 0;
 
     int64_t stats_lazy_decisions = 0;
     vec<Lit> reach_cut;
@@ -878,6 +946,12 @@ public:
         printf("Propagations: %" PRId64 " (%f s, avg: %f s, %" PRId64 " skipped)\n", stats_propagations,
                propagationtime,
                (propagationtime) / ((double) stats_propagations + 1), stats_propagations_skipped);
+        if(stats_parallel_updates > 0){
+            printf("Parallel detector updates: %" PRId64 " (%f s)\n", stats_parallel_updates, stats_parallel_update_time);
+        }
+        printf("Detector propagations: %" PRId64 " (%" PRId64 " skipped as unchanged), %f detectors visited per conflict\n",
+               stats_detector_propagations, stats_detectors_skipped_unchanged,
+               (double) stats_detector_visits_before_conflict / (double) (stats_num_conflicts + 1));
         printf("Decisions: %" PRId64 " (%f s, avg: %f s), lazy decisions: %" PRId64 "\n", stats_decisions,
                stats_decision_time,
                (stats_decision_time) / ((double) stats_decisions + 1), stats_lazy_decisions);
@@ -887,6 +961,11 @@ public:
         printf("enqueues %" PRId64 ", backtracks %" PRId64 " (bv enqueues %" PRId64 " (%" PRId64 " while sat), bv backtracks %" PRId64 ")\n",
                stats_enqueues, stats_backtrack_assigns, stats_bv_enqueues, stats_bv_enqueue_while_sat,
                stats_bv_backtracks);
+        if(opt_graph_dead_edges || opt_graph_forced_edges || opt_graph_contract_chains){
+            printf("Graph preprocessing: %" PRId64 " dead edges, %" PRId64 " forced edge clauses, %" PRId64 " chains contracted (%" PRId64 " edges) (%f s)\n",
+                   stats_dead_edges, stats_forced_edges, stats_contracted_chains, stats_contracted_edges,
+                   stats_graph_preprocess_time);
+        }
 
         fflush(stdout);
 
@@ -1414,7 +1493,7 @@ public:
     };
 
     ~GraphTheorySolver() override{
-
+        delete detector_pool;
     }
 
     void setNodeName(int node, const std::string& symbol){
@@ -1594,7 +1673,9 @@ public:
         Var v = var(l);
         assert(value(l) == l_True);
         lbool assign = sign(l) ? l_False : l_True;
-        if(isEdgeVar(v)){
+        if(isEdgeVar(v) && isRemovedEdge(getEdgeID(v))){
+            //dead edges are left out of the graphs, so there is nothing to undo
+        }else if(isEdgeVar(v)){
             int edge_num = getEdgeID(v); //e.var-min_edge_var;
             assert(assigns[v] != l_Undef);
 
@@ -1622,6 +1703,7 @@ public:
             }
         }else{
             detectors[getDetector(v)]->unassign(mkLit(v, assign == l_False));
+            markDetectorChanged(getDetector(v));
         }
         assigns[v] = l_Undef;
     }
@@ -1632,6 +1714,15 @@ public:
         ++it;
         undoRewind();
 
+        if(max_clean_level > untilLevel){
+            //literals implied by a detector above this level are being unassigned, so it must be propagated again
+            for(DetectorSchedule& s:detector_schedule){
+                if(s.clean_level > untilLevel)
+                    s.clean_level = -1;
+            }
+            max_clean_level = untilLevel;
+        }
+
         //printf("g%d: backtrack until level %d\n", this->id,untilLevel);
         //assert(to_reenqueue.size()==0);
         bool changed = false;
@@ -1648,6 +1739,7 @@ public:
             if(detector >= 0){
 
                 detectors[detector]->setSatisfied(l, false);
+                markDetectorChanged(detector);
                 if(satisfied_detectors[detector] && !detectors[detector]->detectorIsSatisfied()){
                     satisfied_detectors[detector] = false;
                     n_satisfied_detectors--;
@@ -1768,6 +1860,7 @@ public:
             if(detector >= 0){
 
                 detectors[detector]->setSatisfied(l, false);
+                markDetectorChanged(detector);
                 if(satisfied_detectors[detector] && !detectors[detector]->detectorIsSatisfied()){
                     satisfied_detectors[detector] = false;
                     n_satisfied_detectors--;
@@ -2041,6 +2134,7 @@ public:
         int pos = CRef_Undef - marker;
         if(marker_map[pos].forTheory){
             int d = marker_map[pos].id;
+            lemma_detector = -1;
             //double initial_start = rtime(1);
             double start = rtime(1);
             assert(d < detectors.size());
@@ -2052,6 +2146,7 @@ public:
         }else{
 
             int d = marker_map[pos].id;
+            lemma_detector = d;
             //double initial_start = rtime(1);
             double start = rtime(1);
             backtrackUntil(p);
@@ -2179,11 +2274,314 @@ public:
 	 return edge_num;
 	 }*/
 
+    bool hasPendingConstraints() override{
+        return unimplemented_reachability_constraints.size() > 0 || unimplemented_distance_constraints.size() > 0 ||
+               unimplemented_distance_constraints_bv.size() > 0 || unimplemented_maxflow_constraints_bv.size() > 0 ||
+               (graphPreprocessingEnabled() && preprocessed_vars != nVars());
+    }
+
+    bool graphPreprocessingEnabled() const{
+        //removed edges would have to be restored when backtracking lazily past level 0 assignments
+        return (opt_graph_dead_edges || opt_graph_forced_edges || opt_graph_contract_chains) && !opt_lazy_backtrack;
+    }
+
+    //True if the edge is left out of the graphs used by the detectors, because it is dead or part of a contracted chain
+    bool isRemovedEdge(int edgeID) const{
+        return (edgeID < dead_edges.size() && dead_edges[edgeID]) ||
+               (edgeID < contracted_edges.size() && contracted_edges[edgeID]);
+    }
+
+    //Leave an edge out of the graphs used by the detectors (as if it were disabled in all of them), at level 0.
+    //Its literal is still free in the SAT solver.
+    void removeFromGraphs(int edgeID){
+        assert(S->decisionLevel() == 0);
+        g_under.disableEdge(edgeID);
+        g_over.disableEdge(edgeID);
+        if(opt_conflict_min_cut){
+            cutGraph.disableEdge(edgeID * 2);
+            cutGraph.disableEdge(edgeID * 2 + 1);
+        }
+        if(using_neg_weights){
+            g_under_weights_over.disableEdge(edgeID);
+            g_over_weights_under.disableEdge(edgeID);
+        }
+    }
+
+    //Put a removed edge back into the graphs, applying its (level 0) assignment, if it has one.
+    void restoreToGraphs(int edgeID){
+        assert(S->decisionLevel() == 0);
+        assert(!isRemovedEdge(edgeID));
+        g_over.enableEdge(edgeID);
+        if(opt_conflict_min_cut){
+            cutGraph.enableEdge(edgeID * 2 + 1);
+        }
+        if(using_neg_weights){
+            g_over_weights_under.enableEdge(edgeID);
+        }
+        lbool val = value(edge_list[edgeID].v);
+        if(val != l_Undef){
+            assignEdge(edgeID, val == l_True);
+        }
+    }
+
+    void killEdge(int edgeID){
+        assert(value(edge_list[edgeID].v) == l_Undef);
+        if(dead_edges.size() <= edgeID)
+            dead_edges.resize(edgeID + 1, false);
+        dead_edges[edgeID] = true;
+        stats_dead_edges++;
+        removeFromGraphs(edgeID);
+    }
+
+    void reviveEdge(int edgeID){
+        assert(dead_edges[edgeID]);
+        dead_edges[edgeID] = false;
+        stats_dead_edges--;
+        if(!isRemovedEdge(edgeID))
+            restoreToGraphs(edgeID);
+    }
+
+    void setContracted(int edgeID, bool contracted){
+        if(contracted_edges.size() <= edgeID)
+            contracted_edges.resize(edgeID + 1, false);
+        contracted_edges[edgeID] = contracted;
+        if(contracted){
+            removeFromGraphs(edgeID);
+        }else if(!isRemovedEdge(edgeID)){
+            restoreToGraphs(edgeID);
+        }
+    }
+
+    //The number of edges that were added to replace contracted chains (these are always the last edges of the graph)
+    int nChainEdges() const{
+        return chains.size();
+    }
+
+    /**
+	 * Replace each chain of (not yet removed, and not level 0 false) edges u->x1->...->xn->v, in which every inner node
+	 * xi has exactly one incoming and one outgoing edge and is not referred to by any detector, by a new edge u->v.
+	 * The new edge is defined to be enabled exactly when all of the chain's edges are, and has their total weight.
+	 * This is only done if every detector only depends on which of the nodes it refers to are connected by paths, and
+	 * their total weights. Since each new edge is defined in terms of existing edges, this is sound even if clauses
+	 * have already been learnt from the graph (which freezes it), but it is only done once, after which the graph is
+	 * frozen (so that the inner nodes of chains can't gain edges).
+	 * Chains whose inner nodes have since become referred to by a detector (or all chains, if a detector no longer
+	 * supports contraction) are expanded again, restoring their edges.
+	 */
+    void contractChains(){
+        std::vector<bool> endpoints(nNodes(), false);
+        bool all_marked = !assignEdgesToWeight() && !using_neg_weights && !has_any_bitvector_edges &&
+                          edge_bv_weights.size() == 0;
+        for(Detector* d:detectors){
+            if(!all_marked || !d->markPathEndpoints(endpoints)){
+                all_marked = false;
+                break;
+            }
+        }
+        for(int i = 0; i < chains.size(); i++){
+            ContractedChain& chain = chains[i];
+            if(!chain.contracted)
+                continue;
+            bool valid = all_marked;
+            for(int j = 0; valid && j + 1 < chain.edges.size(); j++){
+                if(endpoints[edge_list[chain.edges[j]].to])
+                    valid = false;
+            }
+            if(!valid){
+                //expand this chain; its edge (and the clauses defining it) are left in the solver, but not in the graphs
+                chain.contracted = false;
+                setContracted(chain.edgeID, true);
+                for(int edgeID:chain.edges){
+                    setContracted(edgeID, false);
+                }
+                stats_contracted_chains--;
+                stats_contracted_edges -= chain.edges.size();
+            }
+        }
+        if(!all_marked || chains_searched)
+            return;
+        chains_searched = true;
+
+        //the incoming and outgoing edges of each node, among the edges that may be enabled
+        std::vector<int> n_in(nNodes(), 0);
+        std::vector<int> n_out(nNodes(), 0);
+        std::vector<int> in_edge(nNodes(), -1);
+        std::vector<int> out_edge(nNodes(), -1);
+        int n_edges = edge_list.size();
+        for(int edgeID = 0; edgeID < n_edges; edgeID++){
+            Edge& e = edge_list[edgeID];
+            if(e.v < 0 || isRemovedEdge(edgeID) || value(e.v) == l_False)
+                continue;
+            if(e.from == e.to){
+                //self loops can't be part of a chain
+                endpoints[e.from] = true;
+                continue;
+            }
+            n_out[e.from]++;
+            out_edge[e.from] = edgeID;
+            n_in[e.to]++;
+            in_edge[e.to] = edgeID;
+        }
+        auto inner = [&](int node){
+            return !endpoints[node] && n_in[node] == 1 && n_out[node] == 1;
+        };
+        std::vector<int> chain_edges;
+        vec<Lit> definition;
+        for(int edgeID = 0; edgeID < n_edges; edgeID++){
+            Edge& e = edge_list[edgeID];
+            if(e.v < 0 || isRemovedEdge(edgeID) || value(e.v) == l_False || e.from == e.to)
+                continue;
+            if(inner(e.from) || !inner(e.to))
+                continue;
+            int from = e.from;
+            chain_edges.clear();
+            chain_edges.push_back(edgeID);
+            Weight weight = edge_weights[edgeID];
+            int node = e.to;
+            while(inner(node)){
+                int next = out_edge[node];
+                chain_edges.push_back(next);
+                weight += edge_weights[next];
+                node = edge_list[next].to;
+            }
+            //define the new edge to be the conjunction of the chain's edges
+            bool was_frozen = frozen;
+            frozen = false;
+            Lit chain_lit = newEdge(from, node, S->newVar(), weight);
+            frozen = was_frozen;
+            definition.clear();
+            definition.push(chain_lit);
+            for(int id:chain_edges){
+                Lit l = mkLit(edge_list[id].v);
+                addClause(~chain_lit, l);
+                definition.push(~l);
+            }
+            addClause(definition);
+            int chainID = chains.size();
+            chains.push_back({getEdgeID(var(chain_lit)), chain_edges, true});
+            if(chain_of_edge.size() <= chains.back().edgeID)
+                chain_of_edge.resize(chains.back().edgeID + 1, -1);
+            chain_of_edge[chains.back().edgeID] = chainID;
+            for(int id:chain_edges){
+                setContracted(id, true);
+            }
+            stats_contracted_chains++;
+            stats_contracted_edges += chain_edges.size();
+        }
+        if(chains.size()){
+            //the chains' inner nodes must not gain edges
+            freezeGraph();
+        }
+    }
+
+    //Replace the edges that stand for contracted chains in a path (as returned by a detector, which is a backward
+    //detector if 'backward' is true) by the edges of those chains
+    void expandChainsInPath(std::vector<Lit>& path, bool backward){
+        if(chains.empty())
+            return;
+        std::vector<Lit> expanded;
+        for(Lit l:path){
+            int edgeID = getEdgeID(var(S->getTheoryLit(l, this)));
+            if(edgeID < chain_of_edge.size() && chain_of_edge[edgeID] >= 0 && chains[chain_of_edge[edgeID]].contracted){
+                std::vector<int>& edges = chains[chain_of_edge[edgeID]].edges;
+                for(int i = 0; i < edges.size(); i++){
+                    int id = backward ? edges[edges.size() - 1 - i] : edges[i];
+                    expanded.push_back(mkLit(toSolver(edge_list[id].v), false));
+                }
+            }else{
+                expanded.push_back(l);
+            }
+        }
+        path = expanded;
+    }
+
+    //Get the model's path of nodes to 'node' from a detector (which is a backward detector if 'backward' is true).
+    //If the path uses edges that stand for contracted chains, it is rebuilt from its edges, with those chains expanded.
+    template<class PathDetector>
+    bool getModel_PathExpanded(PathDetector* d, int node, bool backward, std::vector<int>& store_path){
+        bool found = d->getModel_Path(node, store_path);
+        if(found && !chains.empty() && store_path.size() > 1){
+            std::vector<Lit> edges;
+            d->getModel_PathByEdgeLit(node, edges);
+            expandChainsInPath(edges, backward);
+            store_path.resize(1);
+            for(Lit l:edges){
+                Edge& e = edge_list[getEdgeID(var(S->getTheoryLit(l, this)))];
+                store_path.push_back(backward ? e.from : e.to);
+            }
+        }
+        return found;
+    }
+
+    /**
+	 * Graph preprocessing, at level 0, using the over-approximate graph and the sources and nodes of the detectors.
+	 * Chains of edges through nodes that no detector refers to are contracted (see contractChains()). If every detector can tell which edges it depends on (those on some path from its source to one of its nodes),
+	 * the remaining unassigned edges are 'dead', and left out of the graphs that the detectors operate on, whatever
+	 * their assignment. Edges that are on every path from a source to a node (found by dominator analysis) are learnt
+	 * to be enabled whenever an atom that requires that path is true; as with other learnt clauses, this freezes
+	 * the graph.
+	 * This is repeated whenever new atoms are added, before the next solve.
+	 */
+    void preprocessGraph(){
+        assert(S->decisionLevel() == 0);
+        double start_time = rtime(1);
+        //new atoms may depend on edges that were dead before
+        for(int edgeID = 0; edgeID < dead_edges.size(); edgeID++){
+            if(dead_edges[edgeID])
+                reviveEdge(edgeID);
+        }
+        if(opt_graph_contract_chains){
+            contractChains();
+        }
+        if(opt_graph_dead_edges){
+            std::vector<bool> relevant(g_over.nEdgeIDs(), false);
+            bool all_marked = true;
+            for(Detector* d:detectors){
+                if(!d->markRelevantEdges(relevant)){
+                    all_marked = false;
+                    break;
+                }
+            }
+            if(all_marked){
+                for(int edgeID = 0; edgeID < edge_list.size(); edgeID++){
+                    if(edge_list[edgeID].v >= 0 && !relevant[edgeID] && !isRemovedEdge(edgeID) &&
+                       value(edge_list[edgeID].v) == l_Undef)
+                        killEdge(edgeID);
+                }
+            }
+        }
+        if(opt_graph_forced_edges){
+            forced_edges_analyzed.growTo(nVars(), false);
+            vec<Lit> atoms;
+            vec<int> edges;
+            for(Detector* d:detectors){
+                d->findForcedEdges(atoms, edges);
+            }
+            for(int i = 0; i < atoms.size(); i++){
+                Var edge_var = edge_list[edges[i]].v;
+                if(forced_edges_analyzed[var(atoms[i])] || value(edge_var) == l_True)
+                    continue;
+                addClause(~atoms[i], mkLit(edge_var));
+                stats_forced_edges++;
+                freezeGraph();
+            }
+            for(Lit l:atoms){
+                forced_edges_analyzed[var(l)] = true;
+            }
+        }
+        //contracting chains adds edges, and so variables
+        preprocessed_vars = nVars();
+        stats_graph_preprocess_time += rtime(1) - start_time;
+    }
+
     void preprocess() override{
         implementConstraints();
         for(int i = 0; i < detectors.size(); i++){
             detectors[i]->preprocess();
         }
+        if(graphPreprocessingEnabled() && S->decisionLevel() == 0 && preprocessed_vars != nVars()){
+            preprocessGraph();
+        }
         /*g_under.clearHistory(true);
 		g_over.clearHistory(true);
 		g_under_weights_over.clearHistory(true);
@@ -2193,7 +2591,9 @@ public:
 		g_over.clearChanged();
 		cutGraph.clearChanged();*/
 
-        if(opt_lazy_backtrack){
+        //if the solver kept a prefix of assumptions assigned from the last solve, the detectors' unassigned counts
+        //don't reflect level 0; leave this to propagateTheory, which re-checks it at level 0
+        if(opt_lazy_backtrack && S->decisionLevel() == 0){
             lazy_backtracking_enabled = true;
             //currently, lazy backtracking is only supported if _all_ property lits are ground.
             for(Detector* d:detectors){
@@ -2214,6 +2614,7 @@ public:
             //this is a graph property detector var
             //if (!sign(l) && vars[var(l)].occursPositive != occurs)
             detectors[getDetector(var(l))]->setOccurs(l, occurs);
+            markDetectorChanged(getDetector(var(l)));
             //else if (sign(l) && vars[var(l)].occursNegative != occurs)
             //	detectors[getDetector(var(l))]->setOccurs(l, occurs);
         }
@@ -2254,6 +2655,7 @@ public:
             assert(detectorID < detectors.size());
             assert(detectors[detectorID]);
             detectors[detectorID]->assignBV(bvID);
+            markDetectorChanged(detectorID);
         }
     }
 
@@ -2277,6 +2679,7 @@ public:
             assert(detectorID < detectors.size());
             assert(detectors[detectorID]);
             detectors[detectorID]->unassignBV(bvID);
+            markDetectorChanged(detectorID);
         }
     }
 
@@ -2323,9 +2726,6 @@ public:
         Var v = var(l);
         stats_enqueues++;
         int lev = level(v);//level from the SAT solver.
-        if(!opt_lazy_backtrack){
-            assert(decisionLevel() <= lev);
-        }
 
         while(lev > decisionLevel()){
             newDecisionLevel();
@@ -2345,12 +2745,6 @@ public:
             }
             return;
         }else if(opt_lazy_backtrack && value(v) != l_Undef){
-            if(!opt_lazy_backtrack){
-                assert(decisionLevel() <= lev);
-                if(decisionLevel() > lev){
-                    throw std::runtime_error("Internal error in graph enqueue");
-                }
-            }
             assert(value(v) != S->value(toSolver(v)));
             //this literal was already assigned, and then we backtracked _lazily_ without unassigning it in the theory solver.
             //unassign it now, by itself.
@@ -2384,15 +2778,10 @@ public:
             }else{
                 //This is a reachability literal
                 detectors[getDetector(v)]->unassign(l);
+                markDetectorChanged(getDetector(v));
             }
             removeFromTrail(var(l));
         }
-        if(!opt_lazy_backtrack){
-            assert(decisionLevel() <= lev);
-            if(decisionLevel() > lev){
-                throw std::runtime_error("Internal error in graph enqueue");
-            }
-        }
 
         if(g_under.outfile()){
             fprintf(g_under.outfile(), "enqueue %d\n", dimacs(l));
@@ -2407,7 +2796,13 @@ public:
         }
 
         assert(!onTrail(var(l)));
-        appendToTrail(l, decisionLevel());
+        if(lev < decisionLevel() && keepsOutOfOrderLits()){
+            //the solver assigned this literal below our current level (after backtracking chronologically);
+            //record it at its own level, so that it survives backtracking to any level above that.
+            appendToTrail(l, lev);
+        }else{
+            appendToTrail(l, decisionLevel());
+        }
         requiresPropagation = true;
 
         assert(onTrail(var(l)));
@@ -2429,52 +2824,58 @@ public:
             //this is an edge assignment
             int edge_num = getEdgeID(var(l)); //v-min_edge_var;
             assert(edge_list[edge_num].v == var(l));
-
-            int from = edge_list[edge_num].from;
-            int to = edge_list[edge_num].to;
-            if(!sign(l)){
-                g_under.enableEdge(edge_num);
-                if(assignEdgesToWeight()){
-                    g_over.setEdgeWeight(edge_num, assign_edges_to);
-                }
-            }else{
-                g_over.disableEdge(edge_num);
-                if(opt_conflict_min_cut){//can optimize this by also checking if any installed detectors are actually using the cutgraph!
-                    assert(cutGraph.edgeEnabled(edge_num * 2 + 1));
-                    assert(!cutGraph.edgeEnabled(edge_num * 2));
-                    cutGraph.enableEdge(edge_num * 2);
-                    cutGraph.disableEdge(edge_num * 2 + 1);
-                }
-            }
-
-            if(decisionLevel() == 0){
-                //assert(g_under.edgeEnabled(edge_num)== g_over.edgeEnabled(edge_num));
-                g_under.makeEdgeAssignmentConstant(edge_num);
-                g_over.makeEdgeAssignmentConstant(edge_num);
-            }
-
-            if(using_neg_weights){
-                if(!sign(l)){
-                    g_under_weights_over.enableEdge(edge_num);
-                }else{
-                    g_over_weights_under.disableEdge(edge_num);
-                }
-                if(decisionLevel() == 0){
-                    assert(g_under_weights_over.edgeEnabled(edge_num) == g_over_weights_under.edgeEnabled(edge_num));
-                    g_under_weights_over.makeEdgeAssignmentConstant(edge_num);
-                    g_over_weights_under.makeEdgeAssignmentConstant(edge_num);
-                }
+            if(!isRemovedEdge(edge_num)){
+                //dead edges are left out of the graphs (see preprocessGraph())
+                assignEdge(edge_num, !sign(l));
             }
         }else{
             //this is an assignment to a non-edge atom. (eg, a reachability assertion)
             int id = getDetector(var(l));
             detectors[id]->assign(l);
+            markDetectorChanged(id);
             if(detectors[id]->default_heuristic){
                 activateHeuristic(detectors[id]->default_heuristic);
             }
         }
     }
 
+    //Apply an edge assignment to the graphs
+    void assignEdge(int edge_num, bool enabled){
+        if(enabled){
+            g_under.enableEdge(edge_num);
+            if(assignEdgesToWeight()){
+                g_over.setEdgeWeight(edge_num, assign_edges_to);
+            }
+        }else{
+            g_over.disableEdge(edge_num);
+            if(opt_conflict_min_cut){//can optimize this by also checking if any installed detectors are actually using the cutgraph!
+                assert(cutGraph.edgeEnabled(edge_num * 2 + 1));
+                assert(!cutGraph.edgeEnabled(edge_num * 2));
+                cutGraph.enableEdge(edge_num * 2);
+                cutGraph.disableEdge(edge_num * 2 + 1);
+            }
+        }
+
+        if(decisionLevel() == 0){
+            //assert(g_under.edgeEnabled(edge_num)== g_over.edgeEnabled(edge_num));
+            g_under.makeEdgeAssignmentConstant(edge_num);
+            g_over.makeEdgeAssignmentConstant(edge_num);
+        }
+
+        if(using_neg_weights){
+            if(enabled){
+                g_under_weights_over.enableEdge(edge_num);
+            }else{
+                g_over_weights_under.disableEdge(edge_num);
+            }
+            if(decisionLevel() == 0){
+                assert(g_under_weights_over.edgeEnabled(edge_num) == g_over_weights_under.edgeEnabled(edge_num));
+                g_under_weights_over.makeEdgeAssignmentConstant(edge_num);
+                g_over_weights_under.makeEdgeAssignmentConstant(edge_num);
+            }
+        }
+    }
+
     void activateHeuristic(Heuristic* h) override{
         S->activateHeuristic(h);
     }
@@ -2517,6 +2918,107 @@ public:
         return propagateTheory(conflict, false);
     }
 
+    void markDetectorChanged(int detectorID){
+        if(detectorID >= 0 && detectorID < detector_schedule.size()){
+            detector_schedule[detectorID].input_changes++;
+        }
+    }
+
+    GraphVersion getGraphVersion(){
+        GraphVersion v;
+        v.under_history = g_under.getCurrentHistory();
+        v.over_history = g_over.getCurrentHistory();
+        v.under_clears = g_under.historyclears;
+        v.over_clears = g_over.historyclears;
+        if(using_neg_weights){
+            v.under_weights_over_history = g_under_weights_over.getCurrentHistory();
+            v.over_weights_under_history = g_over_weights_under.getCurrentHistory();
+        }
+        return v;
+    }
+
+    //True if none of the graphs, atoms or bitvectors that this detector reads have changed since it was last
+    //propagated without conflict (and the solver has not backtracked past that point), so that propagating it
+    //again cannot imply anything new.
+    bool detectorUnchanged(int detectorID, const GraphVersion& graphs){
+        DetectorSchedule& s = detector_schedule[detectorID];
+        return s.clean_level >= 0 && s.clean_input_changes == s.input_changes && s.clean_graphs == graphs;
+    }
+
+    void bumpDetectorActivity(int detectorID){
+        DetectorSchedule& s = detector_schedule[detectorID];
+        s.activity += detector_activity_inc;
+        if(s.activity > 1e100){
+            //rescale (this preserves the order)
+            for(DetectorSchedule& t:detector_schedule){
+                t.activity *= 1e-100;
+            }
+            detector_activity_inc *= 1e-100;
+        }
+        //move the detector forward in the order, as in an insertion sort
+        int pos = detector_order_pos[detectorID];
+        while(pos > 0 && detector_schedule[detector_order[pos - 1]].activity < s.activity){
+            int prev = detector_order[pos - 1];
+            detector_order[pos] = prev;
+            detector_order_pos[prev] = pos;
+            pos--;
+        }
+        detector_order[pos] = detectorID;
+        detector_order_pos[detectorID] = pos;
+    }
+
+    void decayDetectorActivity(){
+        detector_activity_inc *= (1 / opt_graph_detector_decay);
+    }
+
+    //Collect the detectors to propagate in this round into detectors_to_propagate: by default, all unsatisfied detectors
+    //in order of their IDs, or, with opt_graph_detector_order, in descending order of their (decaying) activity,
+    //which is bumped each time a detector implies a literal or finds a conflict, so that detectors that are likely
+    //to conflict are visited before the others.
+    //With opt_graph_skip_unchanged, detectors whose inputs are unchanged since they were last propagated are skipped.
+    void scheduleDetectors(bool force_propagation){
+        while(detector_schedule.size() < detectors.size()){
+            int d = detector_schedule.size();
+            detector_schedule.push();
+            detector_order_pos.push(detector_order.size());
+            detector_order.push(d);
+        }
+        bool skip_unchanged = opt_graph_skip_unchanged && !force_propagation && !lazy_backtracking_enabled;
+        GraphVersion graphs = getGraphVersion();
+        detectors_to_propagate.clear();
+        for(int i = 0; i < detectors.size(); i++){
+            int d = opt_graph_detector_order ? detector_order[i] : i;
+            if(satisfied_detectors[d])
+                continue;
+            if(skip_unchanged && detectorUnchanged(d, graphs)){
+                stats_detectors_skipped_unchanged++;
+                continue;
+            }
+            detectors_to_propagate.push(d);
+        }
+    }
+
+    //Update the approximations of all scheduled detectors concurrently, before they are propagated.
+    //Nothing is enqueued while the workers run, so they all see the same graphs and assignment. Each detector writes
+    //only to its own state and to the dgl algorithm instances it owns, so those algorithms must not keep static
+    //(shared) mutable state; only reach and distance detectors override updateApproximations(). Detectors are then propagated sequentially, in order, which finds their
+    //approximations already up to date (if an earlier detector changes the graphs, later detectors simply update again),
+    //so implied literals and conflicts are always merged in detector order, and the search does not depend on
+    //the number of threads or on how the updates were scheduled.
+    void updateDetectorsInParallel(){
+        if(detectors_to_propagate.size() < 2)
+            return;
+        if(!detector_pool){
+            detector_pool = new ThreadPool(opt_graph_prop_threads);
+        }
+        double start_time = rtime(1);
+        stats_parallel_updates++;
+        detector_pool->parallelFor(detectors_to_propagate.size(), [&](int i){
+            detectors[detectors_to_propagate[i]]->updateApproximations();
+        });
+        stats_parallel_update_time += rtime(1) - start_time;
+    }
+
     Heuristic* conflictingHeuristic = nullptr;
 
     Heuristic* getConflictingHeuristic() override{
@@ -2527,6 +3029,7 @@ public:
     bool propagateTheory(vec<Lit>& conflict, bool force_propagation){
         dbg_check_trails();
         conflictingHeuristic = this;
+        lemma_detector = -1;
         if(theoryIsSatisfied()){
             S->setTheorySatisfied(this);
             if(bvTheory){
@@ -2634,17 +3137,41 @@ public:
         //dbg_sync();
         assert(dbg_graphsUpToDate());
 
-        for(int d = 0; d < detectors.size(); d++){
+        scheduleDetectors(force_propagation);
+        if(opt_graph_prop_threads > 1){
+            updateDetectorsInParallel();
+        }
+
+        for(int i = 0; i < detectors_to_propagate.size(); i++){
+            int d = detectors_to_propagate[i];
             if(satisfied_detectors[d])
                 continue;
             assert(conflict.size() == 0);
             Lit l = lit_Undef;
             bool backtrackOnly = lazy_backtracking_enabled && (opt_lazy_conflicts == 3) && lazy_trail_head != var_Undef;
+            DetectorSchedule& schedule = detector_schedule[d];
+            int64_t input_changes = schedule.input_changes;
+            GraphVersion graphs = getGraphVersion();
+            int64_t enqueues = stats_enqueues;
+            stats_detector_propagations++;
+            lemma_detector = d;
             bool r = detectors[d]->propagate(conflict, backtrackOnly, l);
+            if(r){
+                //anything this detector enqueued has changed its inputs, so it will be propagated again next round
+                schedule.clean_level = decisionLevel();
+                schedule.clean_input_changes = input_changes;
+                schedule.clean_graphs = graphs;
+                max_clean_level = std::max(max_clean_level, schedule.clean_level);
+                if(stats_enqueues > enqueues){
+                    bumpDetectorActivity(d);
+                }
+            }else{
+                schedule.clean_level = -1;
+            }
             if(!r && backtrackOnly && conflict.size() == 0){
                 backtrackUntil(decisionLevel());
                 stats_num_lazy_conflicts++;
-                d = -1;
+                i = -1;
                 continue;
             }
 
@@ -2744,11 +3271,14 @@ public:
                         conflict.clear();
                         //restart the loop, as assignments have changed... actually, this shouldn't be neccesary (only the current propagation should be re-started)
                         //as we have not backtracked past the current level in the SAT solver.
-                        d = -1;
+                        i = -1;
                         continue;
                     }
                 }
                 stats_num_conflicts++;
+                stats_detector_visits_before_conflict += i + 1;
+                bumpDetectorActivity(d);
+                decayDetectorActivity();
                 conflictingHeuristic = detectors[d]->getConflictingHeuristic();
                 propagationtime += rtime(1) - startproptime;
                 return false;
@@ -2791,6 +3321,35 @@ public:
         return lazy_backtracking_enabled;
     }
 
+    bool supportsChronologicalBacktracking() override{
+        return true;
+    }
+
+    int lemma_detector = -1;//the detector that produced the most recent conflict, reason or propagation
+
+    int explainLemma(const vec<Lit>& lemma, vec<int>& witness) override{
+        //the witness is the set of edges in the lemma (e.g., the edges of a cut, or of a path)
+        witness.clear();
+        for(Lit l:lemma){
+            if(isEdgeVar(var(l))){
+                witness.push(getEdgeID(var(l)));
+            }
+        }
+        return lemma_detector;
+    }
+
+    //Literals assigned below the current level can only be kept at their own level if this theory's trail is the only
+    //record of them; the bitvector theory (and any sub-theories) keep their own, strictly chronological, trails.
+    bool keepsOutOfOrderLits(){
+        return !bvTheory && theories.size() == 0 && !supportsLazyBacktracking();
+    }
+
+    bool supportsSkippingBacktrack() override{
+        //edge weight bitvectors are backtracked (and rewound, during conflict analysis) by the bitvector theory,
+        //which the solver doesn't track on this theory's behalf
+        return !bvTheory && theories.size() == 0;
+    }
+
     bool solveTheory(vec<Lit>& conflict) override{
         n_theory_solves++;
         requiresPropagation = true;        //Just to be on the safe side... but this shouldn't really be required.
@@ -2883,7 +3442,7 @@ public:
         }
 
         for(int i = 0; i < edge_list.size(); i++){
-            if(edge_list[i].v < 0)
+            if(edge_list[i].v < 0 || isRemovedEdge(i))
                 continue;
             Edge& e = edge_list[i];
             lbool val = value(e.v);
@@ -4336,20 +4895,20 @@ public:
 
         if(ReachDetector<Weight>* r = dynamic_cast<ReachDetector<Weight>*>(d)){
             int node = r->getNode(v);
-            return r->getModel_Path(node, store_path);
+            return getModel_PathExpanded(r, node, false, store_path);
         }
         if(ReachDetector<Weight, DynamicBackGraph<Weight>>* rback = dynamic_cast<ReachDetector<Weight, DynamicBackGraph<Weight>>*>(d)){
             int node = rback->getNode(v);
-            return rback->getModel_Path(node, store_path);
+            return getModel_PathExpanded(rback, node, true, store_path);
         }
 
         if(DistanceDetector<Weight>* dist = dynamic_cast<DistanceDetector<Weight>*>(d)){
             int node = dist->getNode(v);
-            return dist->getModel_Path(node, store_path);
+            return getModel_PathExpanded(dist, node, false, store_path);
         }
         if(WeightedDistanceDetector<Weight>* dist2 = dynamic_cast<WeightedDistanceDetector<Weight>*>(d)){
             int node = dist2->getNode(v);
-            return dist2->getModel_Path(node, store_path);
+            return getModel_PathExpanded(dist2, node, false, store_path);
         }
 
         throw std::runtime_error("Literal " + std::to_string(toInt(solverLit)) + " is not a reach/distance literal");
@@ -4384,20 +4943,28 @@ public:
 
         if(ReachDetector<Weight>* r = dynamic_cast<ReachDetector<Weight>*>(d)){
             int node = r->getNode(v);
-            return r->getModel_PathByEdgeLit(node, store_path);
+            bool found = r->getModel_PathByEdgeLit(node, store_path);
+            expandChainsInPath(store_path, false);
+            return found;
         }
         if(ReachDetector<Weight, DynamicBackGraph<Weight>>* rback = dynamic_cast<ReachDetector<Weight, DynamicBackGraph<Weight>>*>(d)){
             int node = rback->getNode(v);
-            return rback->getModel_PathByEdgeLit(node, store_path);
+            bool found = rback->getModel_PathByEdgeLit(node, store_path);
+            expandChainsInPath(store_path, true);
+            return found;
         }
 
         if(DistanceDetector<Weight>* dist = dynamic_cast<DistanceDetector<Weight>*>(d)){
             int node = dist->getNode(v);
-            return dist->getModel_PathByEdgeLit(node, store_path);
+            bool found = dist->getModel_PathByEdgeLit(node, store_path);
+            expandChainsInPath(store_path, false);
+            return found;
         }
         if(WeightedDistanceDetector<Weight>* dist2 = dynamic_cast<WeightedDistanceDetector<Weight>*>(d)){
             int node = dist2->getNode(v);
-            return dist2->getModel_PathByEdgeLit(node, store_path);
+            bool found = dist2->getModel_PathByEdgeLit(node, store_path);
+            expandChainsInPath(store_path, false);
+            return found;
         }
         throw std::runtime_error("Literal " + std::to_string(toInt(solverLit)) + " is not a reach/distance literal");
     }
@@ -31,6 +31,7 @@
 #include "monosat/graph/GraphHeuristic.h"
 #include "monosat/graph/MaxflowDetector.h"
 #include "monosat/dgl/CachedReach.h"
+#include "monosat/dgl/EdgeDominators.h"
 
 using namespace Monosat;
 
@@ -1224,6 +1225,44 @@ void ReachDetector<Weight, Graph>::preprocess(){
     //can check if all reach lits appear in only one polarity in the solver constraints; if so, then we can disable either check_positive or check_negative
 }
 
+template<typename Weight, typename Graph>
+bool ReachDetector<Weight, Graph>::markRelevantEdges(std::vector<bool>& relevant){
+    std::vector<int> targets;
+    for(int node = 0; node < reach_lits.size(); node++){
+        if(reach_lits[node] != lit_Undef)
+            targets.push_back(node);
+    }
+    markPathEdges(g_over, source, targets, relevant);
+    return true;
+}
+
+template<typename Weight, typename Graph>
+void ReachDetector<Weight, Graph>::findForcedEdges(vec<Lit>& atoms, vec<int>& edges){
+    EdgeDominators<Graph> dominators(g_over, source);
+    dominators.run();
+    std::vector<int> path_edges;
+    for(int node = 0; node < reach_lits.size(); node++){
+        Lit l = reach_lits[node];
+        if(l == lit_Undef || outer->value(l) == l_False || !dominators.reachable(node))
+            continue;
+        dominators.getDominatingEdges(node, path_edges);
+        for(int edgeID:path_edges){
+            atoms.push(l);
+            edges.push(edgeID);
+        }
+    }
+}
+
+template<typename Weight, typename Graph>
+bool ReachDetector<Weight, Graph>::markPathEndpoints(std::vector<bool>& endpoints){
+    endpoints[source] = true;
+    for(int node = 0; node < reach_lits.size(); node++){
+        if(reach_lits[node] != lit_Undef)
+            endpoints[node] = true;
+    }
+    return true;
+}
+
 template<typename Weight, typename Graph>
 void ReachDetector<Weight, Graph>::buildReachReason(int node, vec<Lit>& conflict){
     //drawFull();
@@ -1344,6 +1383,8 @@ void ReachDetector<Weight, Graph>::buildNonReachReason(int node, vec<Lit>& confl
                 int v = outer->getEdgeVar(g_over.incoming(u, i).id);
                 int from = g_over.incoming(u, i).node;
                 int edge_num = outer->getEdgeID(v);                        // v-outer->min_edge_var;
+                if(outer->isRemovedEdge(edge_num))
+                    continue;//left out of the graphs by preprocessing (see GraphTheorySolver::preprocessGraph)
                 if(from == u){
                     assert(g_over.getEdge(edge_num).to == u);
                     assert(g_over.getEdge(edge_num).from == u);
@@ -1616,6 +1657,8 @@ void ReachDetector<Weight, Graph>::buildForcedEdgeReason(int reach_node, int for
                 int from = g_over.incoming(u, i).node;
                 //Note: the variable has to not only be assigned false, but assigned false earlier in the trail than the reach variable...
                 int edge_num = outer->getEdgeID(v);                        // v-outer->min_edge_var;
+                if(outer->isRemovedEdge(edge_num))
+                    continue;
 
                 if(edge_num == forced_edge_id || outer->value(v) == l_False){
                     //note: we know we haven't seen this edge variable before, because we know we haven't visited this node before
@@ -1704,6 +1747,20 @@ void ReachDetector<Weight, Graph>::buildReason(Lit p, vec<Lit>& reason, CRef mar
     outer->toSolver(reason);
 }
 
+template<typename Weight, typename Graph>
+void ReachDetector<Weight, Graph>::updateApproximations(){
+    if(underapprox_detector && (!opt_detect_pure_theory_lits || unassigned_positives > 0)){
+        double startdreachtime = rtime(2);
+        underapprox_detector->update();
+        stats_under_update_time += rtime(2) - startdreachtime;
+    }
+    if(overapprox_reach_detector && (!opt_detect_pure_theory_lits || unassigned_negatives > 0)){
+        double startunreachtime = rtime(2);
+        overapprox_reach_detector->update();
+        stats_over_update_time += rtime(2) - startunreachtime;
+    }
+}
+
 template<typename Weight, typename Graph>
 bool ReachDetector<Weight, Graph>::propagate(vec<Lit>& conflict){
     static int iter = 0;
@@ -340,6 +340,8 @@ public:
 
     bool propagate(vec<Lit>& conflict) override;
 
+    void updateApproximations() override;
+
     void buildReachReason(int node, vec<Lit>& conflict);
 
     void buildNonReachReason(int node, vec<Lit>& conflict, bool force_maxflow = false);
@@ -358,6 +360,12 @@ public:
 
     void preprocess() override;
 
+    bool markRelevantEdges(std::vector<bool>& relevant) override;
+
+    void findForcedEdges(vec<Lit>& atoms, vec<int>& edges) override;
+
+    bool markPathEndpoints(std::vector<bool>& endpoints) override;
+
     void dbg_sync_reachability();
 
     ReachDetector(int _detectorID, GraphTheorySolver<Weight>* _outer, Graph& g_under, Graph& g_over, Graph& cutGraph,
@@ -26,6 +26,7 @@
 #include "monosat/dgl/KohliTorr.h"
 #include "monosat/dgl/EdmondsKarpDynamic.h"
 #include "monosat/dgl/Dinics.h"
+#include "monosat/dgl/EdgeDominators.h"
 #include "monosat/dgl/DynamicGraph.h"
 #include "monosat/dgl/Graph.h"
 #include "monosat/dgl/DinicsLinkCut.h"
@@ -357,6 +358,8 @@ void WeightedDistanceDetector<Weight, Graph>::analyzeDistanceGTReason(int to, We
 
                 //Note: the variable has to not only be assigned false, but assigned false earlier in the trail than the reach variable...
                 Var edge_enabled = outer->getEdgeVar(edge_num);
+                if(outer->isRemovedEdge(edge_num))
+                    continue;//left out of the graphs by preprocessing (see GraphTheorySolver::preprocessGraph)
                 if(from == u){
 
                     continue; //Self loops are allowed, but just make sure nothing got flipped around...
@@ -561,6 +564,67 @@ void WeightedDistanceDetector<Weight, Graph>::preprocess(){
 }
 
 
+template<typename Weight, typename Graph>
+bool WeightedDistanceDetector<Weight, Graph>::markRelevantEdges(std::vector<bool>& relevant){
+    std::vector<int> targets;
+    for(auto& d:weighted_dist_lits)
+        targets.push_back(d.u);
+    for(auto& d:weighted_dist_bv_lits)
+        targets.push_back(d.u);
+    markPathEdges(g_over, source, targets, relevant);
+    return true;
+}
+
+template<typename Weight, typename Graph>
+void WeightedDistanceDetector<Weight, Graph>::findForcedEdges(vec<Lit>& atoms, vec<int>& edges){
+    EdgeDominators<Graph> dominators(g_over, source);
+    dominators.run();
+    std::vector<int> path_edges;
+    //a weighted distance atom that is true requires a path to its node
+    for(auto& d:weighted_dist_lits){
+        if(outer->value(d.l) == l_False || !dominators.reachable(d.u))
+            continue;
+        dominators.getDominatingEdges(d.u, path_edges);
+        for(int edgeID:path_edges){
+            atoms.push(d.l);
+            edges.push(edgeID);
+        }
+    }
+    for(auto& d:weighted_dist_bv_lits){
+        if(outer->value(d.l) == l_False || !dominators.reachable(d.u))
+            continue;
+        dominators.getDominatingEdges(d.u, path_edges);
+        for(int edgeID:path_edges){
+            atoms.push(d.l);
+            edges.push(edgeID);
+        }
+    }
+}
+
+template<typename Weight, typename Graph>
+bool WeightedDistanceDetector<Weight, Graph>::markPathEndpoints(std::vector<bool>& endpoints){
+    endpoints[source] = true;
+    for(auto& d:weighted_dist_lits)
+        endpoints[d.u] = true;
+    for(auto& d:weighted_dist_bv_lits)
+        endpoints[d.u] = true;
+    return true;
+}
+
+template<typename Weight, typename Graph>
+void WeightedDistanceDetector<Weight, Graph>::updateApproximations(){
+    if(!opt_detect_pure_theory_lits || unassigned_positives > 0){
+        double startdreachtime = rtime(2);
+        underapprox_weighted_distance_detector->update();
+        stats_under_update_time += rtime(2) - startdreachtime;
+    }
+    if(!opt_detect_pure_theory_lits || unassigned_negatives > 0){
+        double startunreachtime = rtime(2);
+        overapprox_weighted_distance_detector->update();
+        stats_over_update_time += rtime(2) - startunreachtime;
+    }
+}
+
 template<typename Weight, typename Graph>
 bool WeightedDistanceDetector<Weight, Graph>::propagate(vec<Lit>& conflict){
 
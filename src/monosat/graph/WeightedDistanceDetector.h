@@ -335,8 +335,16 @@ public:
 
     void preprocess() override;
 
+    bool markRelevantEdges(std::vector<bool>& relevant) override;
+
+    void findForcedEdges(vec <Lit>& atoms, vec<int>& edges) override;
+
+    bool markPathEndpoints(std::vector<bool>& endpoints) override;
+
     bool propagate(vec <Lit>& conflict) override;
 
+    void updateApproximations() override;
+
     void buildDistanceLEQReason(int to, Weight& min_distance, vec <Lit>& conflict, bool strictComparison = false);
 
     void buildDistanceGTReason(int to, Weight& min_distance, vec <Lit>& conflict, bool strictComparison = true);
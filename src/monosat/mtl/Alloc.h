@@ -67,6 +67,13 @@ public:
 
     Ref alloc(int size);
 
+    // Make sure that 'size' more units can be allocated without moving the region.
+    void reserve(uint64_t size){
+        if(sz + size > UINT32_MAX)
+            throw OutOfMemoryException();
+        capacity(sz + size);
+    }
+
     void free(int size){
         wasted_ += size;
     }
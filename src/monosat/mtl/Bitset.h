@@ -29,7 +29,8 @@
 namespace Monosat {
 
 //=================================================================================================
-#define BITSET_ELEMENT_SIZE (sizeof(uint64_t))
+//Number of bits stored in each 64-bit word of a Bitset (every bit of the word is used).
+#define BITSET_ELEMENT_SIZE (sizeof(uint64_t) * 8)
 
 class Bitset {
     vec <uint64_t> buf;
@@ -89,6 +90,20 @@ public:
 
     int size() const{return sz;}
 
+    //Direct access to the underlying 64-bit words, for word-parallel algorithms.
+    int nWords() const{return buf.size();}
+
+    inline uint64_t getWord(int i) const{return buf[i];}
+
+    //true if any bit is set
+    bool any() const{
+        for(int i = 0; i < buf.size(); i++){
+            if(buf[i])
+                return true;
+        }
+        return false;
+    }
+
 private:
     static int popcount(uint64_t i){
         //http://stackoverflow.com/a/2709523
@@ -130,7 +145,7 @@ public:
         int i = index / BITSET_ELEMENT_SIZE;
         int rem = index % BITSET_ELEMENT_SIZE;
         assert(i < buf.size());
-        return buf[i] & (1 << rem);
+        return buf[i] & (((uint64_t) 1) << rem);
     }
 
     inline void set(int index){
@@ -138,7 +153,7 @@ public:
         int i = index / BITSET_ELEMENT_SIZE;
         int r = index % BITSET_ELEMENT_SIZE;
 
-        buf[i] |= (1 << r);
+        buf[i] |= (((uint64_t) 1) << r);
 
     }
 
@@ -147,7 +162,7 @@ public:
         int i = index / BITSET_ELEMENT_SIZE;
         int r = index % BITSET_ELEMENT_SIZE;
 
-        buf[i] &= ~(1 << r);
+        buf[i] &= ~(((uint64_t) 1) << r);
 
     }
 
@@ -156,7 +171,7 @@ public:
         int i = index / BITSET_ELEMENT_SIZE;
         int r = index % BITSET_ELEMENT_SIZE;
 
-        buf[i] ^= (1 << r);
+        buf[i] ^= (((uint64_t) 1) << r);
 
     }
 
@@ -152,6 +152,14 @@ public:
 
     }
 
+    bool supportsChronologicalBacktracking() override{
+        return true;
+    }
+
+    bool supportsSkippingBacktrack() override{
+        return true;
+    }
+
     inline int decisionLevel(){
         return S->decisionLevel();
     }
@@ -107,13 +107,33 @@ bool SimpSolver::propagateAssignment(const vec<Lit>& assumps){
     return val == l_True;
 }
 
+bool SimpSolver::simplificationPending() const{
+    //clauses can only be added at level 0, so if the solver is still at a higher level, then no clauses have
+    //been added since the last solve; but there may still be new level 0 assignments or candidate variables
+    int level0_assigns = decisionLevel() > 0 ? trail_lim[0] : trail.size();
+    if(initialPropagate || n_touched > 0 || elim_heap.size() > 0 || subsumption_queue.size() > 0 ||
+       bwdsub_assigns < level0_assigns){
+        return true;
+    }
+    for(Lit l:assumptions){
+        if(isEliminated(var(l))){
+            return true;
+        }
+    }
+    return false;
+}
+
 lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp){
     vec<Var> extra_frozen;
     lbool result = l_True;
     clearInterrupt();
-    cancelUntil(0);
     do_simp &= ok && use_simplification;
+    if(do_simp && decisionLevel() > 0 && opt_reuse_assumptions && !simplificationPending()){
+        //nothing has changed since the last elimination, so don't backtrack to level 0 just to run it again
+        do_simp = false;
+    }
     if(do_simp){
+        cancelUntil(0);
         if(pbsolver){
             pbsolver->convert();
         }
@@ -132,12 +152,18 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp){
         }
 
         result = lbool(eliminate(turn_off_simp));
+    }else{
+        //keep any assumptions that are unchanged from the previous solve assigned
+        cancelUntilAssumptions(assumptions);
     }
 
     if(result == l_True)
         result = Solver::solve_();
-    else if(verbosity >= 1)
-        printf("===============================================================================\n");
+    else{
+        proofResult(result);
+        if(verbosity >= 1)
+            printf("===============================================================================\n");
+    }
 
     if(result == l_True)
         extendModel();
@@ -150,7 +176,7 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp){
     return result;
 }
 
-bool SimpSolver::addClause_(vec<Lit>& ps, bool is_derived_clause){
+bool SimpSolver::addClause_(vec<Lit>& ps, bool is_derived_clause, bool proof_logged){
 #ifdef DEBUG_CORE
     for(int i = 0; i < ps.size(); i++)
         assert(!isEliminated(var(ps[i])));
@@ -161,7 +187,7 @@ bool SimpSolver::addClause_(vec<Lit>& ps, bool is_derived_clause){
     if(use_rcheck && implied(ps))
         return true;
 
-    if(!Solver::addClause_(ps, is_derived_clause))
+    if(!Solver::addClause_(ps, is_derived_clause, proof_logged))
         return false;
 
     if(use_simplification && clauses.size() == nclauses + 1){
@@ -210,6 +236,19 @@ bool SimpSolver::strengthenClause(CRef cr, Lit l){
     // if (!find(subsumption_queue, &c))
     subsumption_queue.insert(cr);
 
+    if(proof){
+        //record the strengthened clause, and delete the original here, as it may be modified before it is removed below
+        proof_lemma.clear();
+        for(int i = 0; i < c.size(); i++){
+            if(c[i] != l && value(c[i]) != l_False){
+                proof_lemma.push(c[i]);
+            }
+        }
+        proofClause('a', proof_lemma);
+        proofClause('d', c);
+        proof_skip_deletes = true;
+    }
+
     if(c.size() == 2){
         removeClause(cr);
         c.strengthen(l);
@@ -232,13 +271,16 @@ bool SimpSolver::strengthenClause(CRef cr, Lit l){
             }
         }
         if(size == -1){
+            proof_skip_deletes = false;
             return true;
         }else if(size == 0){
             ok = false;
+            proof_skip_deletes = false;
             return false;
         }else if(size == 1){
             ok = false;
             c.strengthen(l);
+            proof_skip_deletes = false;
             return false;
         }else if(size == 2){
             removeClause(cr);
@@ -251,6 +293,7 @@ bool SimpSolver::strengthenClause(CRef cr, Lit l){
             updateElimHeap(var(l));
         }
     }
+    proof_skip_deletes = false;
 
     return c.size() == 1 ?
            enqueue(c[0]) &&
@@ -539,17 +582,24 @@ bool SimpSolver::eliminateVar(Var v){
             mkElimClause(elimclauses, v, ca[pos[i]]);
         mkElimClause(elimclauses, ~mkLit(v));
     }
+    vec<Lit>& resolvent = add_tmp;
+    if(proof){
+        //the resolvents must be in the proof before the clauses they were derived from are deleted
+        for(int i = 0; i < pos.size(); i++)
+            for(int j = 0; j < neg.size(); j++)
+                if(merge(ca[pos[i]], ca[neg[j]], v, resolvent))
+                    proofClause('a', resolvent);
+    }
     bool all_derived = true;
     for(int i = 0; i < cls.size(); i++){
         all_derived &= ca[cls[i]].derivedClause();
         removeClause(cls[i]);
     }
     // Produce clauses in cross product:
-    vec<Lit>& resolvent = add_tmp;
     for(int i = 0; i < pos.size(); i++)
         for(int j = 0; j < neg.size(); j++)
             if(merge(ca[pos[i]], ca[neg[j]], v, resolvent) &&
-               !addClause_(resolvent, all_derived))//should this clause always be treated as derived?
+               !addClause_(resolvent, all_derived, true))//should this clause always be treated as derived?
                 return false;
 
     // Free occurs list for this variable:
@@ -585,10 +635,13 @@ bool SimpSolver::substitute(Var v, Lit x){
             Lit p = c[j];
             subst_clause.push(var(p) == v ? x ^ sign(p) : p);
         }
+        if(proof){
+            proofClause('a', subst_clause);
+        }
 
         removeClause(cls[i]);
 
-        if(!addClause_(subst_clause))//should this clause be treated as derived?
+        if(!addClause_(subst_clause, false, true))//should this clause be treated as derived?
             return (ok = false);
     }
 
@@ -72,8 +72,9 @@ public:
     bool addClause(Lit p) override;               // Add a unit clause to the solver.
     bool addClause(Lit p, Lit q) override;        // Add a binary clause to the solver.
     bool addClause(Lit p, Lit q, Lit r) override; // Add a ternary clause to the solver.
+    bool addClauses(const vec<Lit>& lits, const int* offsets, int n_clauses) override;
 
-    bool addClause_(vec<Lit>& ps, bool is_derived_clause = false);
+    bool addClause_(vec<Lit>& ps, bool is_derived_clause = false, bool proof_logged = false);
 
     bool substitute(Var v, Lit x);  // Replace all occurences of v with x (may cause a contradiction).
 
@@ -242,6 +243,8 @@ protected:
     //
     lbool solve_(bool do_simp = true, bool turn_off_simp = false);
 
+    bool simplificationPending() const;   // True if eliminate() may have work to do since it was last called.
+
     bool asymm(Var v, CRef cr);
 
     bool asymmVar(Var v);
@@ -291,6 +294,18 @@ inline bool SimpSolver::addClause(const vec<Lit>& ps){
     return addClause_(add_tmp);
 }
 
+inline bool SimpSolver::addClauses(const vec<Lit>& lits, const int* offsets, int n_clauses){
+    cancelUntil(0);
+    reserveClauses(n_clauses, offsets[n_clauses] - offsets[0]);
+    for(int i = 0; i < n_clauses && ok; i++){
+        add_tmp.clear();
+        for(int j = offsets[i]; j < offsets[i + 1]; j++)
+            add_tmp.push(lits[j]);
+        addClause_(add_tmp);
+    }
+    return ok;
+}
+
 inline bool SimpSolver::addEmptyClause(){
     cancelUntil(0);
     add_tmp.clear();
@@ -0,0 +1,93 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2026, The MonoSAT Contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/utils/ThreadPool.h"
+
+using namespace Monosat;
+
+ThreadPool::ThreadPool(int n_threads) : next_task(0){
+    for(int i = 1; i < n_threads; i++){
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        closing = true;
+    }
+    start.notify_all();
+    for(std::thread& t:workers){
+        t.join();
+    }
+}
+
+void ThreadPool::parallelFor(int n, const std::function<void(int)>& fn){
+    if(n <= 0){
+        return;
+    }
+    if(workers.empty() || n == 1){
+        for(int i = 0; i < n; i++){
+            fn(i);
+        }
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        task = &fn;
+        n_tasks = n;
+        next_task = 0;
+        n_busy = workers.size();
+        generation++;
+    }
+    start.notify_all();
+    runTasks(fn, n);
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&]{return n_busy == 0;});
+    task = nullptr;
+}
+
+void ThreadPool::runTasks(const std::function<void(int)>& fn, int n){
+    int i;
+    while((i = next_task.fetch_add(1)) < n){
+        fn(i);
+    }
+}
+
+void ThreadPool::workerLoop(){
+    uint64_t seen_generation = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while(true){
+        start.wait(lock, [&]{return closing || generation != seen_generation;});
+        if(closing){
+            return;
+        }
+        seen_generation = generation;
+        const std::function<void(int)>& fn = *task;
+        int n = n_tasks;
+        lock.unlock();
+        runTasks(fn, n);
+        lock.lock();
+        if(--n_busy == 0){
+            done.notify_one();
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2026, The MonoSAT Contributors
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef MONOSAT_THREADPOOL_H
+#define MONOSAT_THREADPOOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Monosat {
+
+/**
+ * A small pool of persistent worker threads, for running many short, independent tasks in parallel.
+ * The workers are kept alive between calls to parallelFor (so that repeated calls, e.g. once per theory propagation,
+ * don't pay for thread creation), and tasks are handed out one index at a time from a shared counter,
+ * so that threads that finish early pick up the remaining work.
+ */
+class ThreadPool {
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable start;
+    std::condition_variable done;
+
+    const std::function<void(int)>* task = nullptr;
+    int n_tasks = 0;
+    std::atomic<int> next_task;
+    int n_busy = 0;
+    uint64_t generation = 0;
+    bool closing = false;
+
+public:
+    //Creates a pool that runs tasks on 'n_threads' threads in total (including the thread calling parallelFor).
+    explicit ThreadPool(int n_threads);
+
+    ~ThreadPool();
+
+    int nThreads() const{
+        return workers.size() + 1;
+    }
+
+    //Calls fn(i) for each i in [0,n), in parallel, and returns once all calls have completed.
+    //The calling thread also runs tasks. Not re-entrant: fn must not call parallelFor on the same pool.
+    void parallelFor(int n, const std::function<void(int)>& fn);
+
+private:
+    void workerLoop();
+
+    void runTasks(const std::function<void(int)>& fn, int n);
+};
+}
+
+#endif //MONOSAT_THREADPOOL_H